@@ -0,0 +1,365 @@
+#include "Analytics.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <iostream>
+
+#include "Metrics.h"
+#include "ThreadPool.h"
+
+using namespace std;
+
+namespace
+{
+    //     (),   TicketAggregate
+    struct CompensatedSum
+    {
+        double sum = 0.0;
+        double compensation = 0.0;
+
+        void add(double value)
+        {
+            double next = sum + value;
+            if (fabs(sum) >= fabs(value))
+            {
+                compensation += (sum - next) + value;
+            }
+            else
+            {
+                compensation += (value - next) + sum;
+            }
+            sum = next;
+        }
+
+        void add(const CompensatedSum &other)
+        {
+            add(other.sum);
+            compensation += other.compensation;
+        }
+
+        double value() const { return sum + compensation; }
+    };
+
+    struct RevenueTotals
+    {
+        size_t tickets = 0;
+        CompensatedSum revenue;
+    };
+
+    // ϳ  ,   :   
+    //      ,    
+    //   (  ),     
+    //    . ' -      
+    //        .
+    vector<RevenueTotals> totalsByRange(const uint32_t *keys, const double *prices, size_t rows, size_t keyCount)
+    {
+        ThreadPool &pool = threadPool();
+        size_t rangeKeys = max<size_t>((keyCount + pool.size() * 8 - 1) / (pool.size() * 8), 1);
+        size_t ranges = (keyCount + rangeKeys - 1) / rangeKeys;
+        size_t morsels = (rows + morselRows - 1) / morselRows;
+
+        // ʳ      
+        vector<uint32_t> counts(morsels * ranges, 0);
+        pool.parallelFor(rows, morselRows, [&](size_t, size_t begin, size_t end)
+                         {
+                             uint32_t *count = &counts[begin / morselRows * ranges];
+                             for (size_t row = begin; row < end; row++)
+                             {
+                                 count[keys[row] / rangeKeys]++;
+                             }
+                         });
+
+        //        
+        vector<size_t> rangeStarts(ranges + 1, 0);
+        vector<size_t> offsets(morsels * ranges);
+        size_t position = 0;
+        for (size_t range = 0; range < ranges; range++)
+        {
+            rangeStarts[range] = position;
+            for (size_t morsel = 0; morsel < morsels; morsel++)
+            {
+                offsets[morsel * ranges + range] = position;
+                position += counts[morsel * ranges + range];
+            }
+        }
+        rangeStarts[ranges] = position;
+
+        vector<uint32_t> order(rows);
+        pool.parallelFor(rows, morselRows, [&](size_t, size_t begin, size_t end)
+                         {
+                             size_t *offset = &offsets[begin / morselRows * ranges];
+                             for (size_t row = begin; row < end; row++)
+                             {
+                                 order[offset[keys[row] / rangeKeys]++] = static_cast<uint32_t>(row);
+                             }
+                         });
+
+        // ĳ  ,      
+        vector<RevenueTotals> totals(keyCount);
+        pool.parallelFor(ranges, 1, [&](size_t, size_t begin, size_t end)
+                         {
+                             for (size_t i = rangeStarts[begin]; i < rangeStarts[end]; i++)
+                             {
+                                 RevenueTotals &key = totals[keys[order[i]]];
+                                 key.tickets++;
+                                 key.revenue.add(prices[order[i]]);
+                             }
+                         });
+        return totals;
+    }
+
+    // ϳ    (  )  .
+    //    ()      ;
+    //      ,    (), 
+    //     (totalsByRange).
+    vector<RevenueTotals> totalsBy(const uint32_t *keys, const double *prices, size_t rows, size_t keyCount)
+    {
+        if (keyCount * sizeof(RevenueTotals) * threadPool().size() > rows * sizeof(uint32_t))
+        {
+            return totalsByRange(keys, prices, rows, keyCount);
+        }
+        return parallelAggregate(
+            rows, vector<RevenueTotals>(keyCount),
+            [keys, prices](vector<RevenueTotals> &partial, size_t begin, size_t end)
+            {
+                for (size_t row = begin; row < end; row++)
+                {
+                    RevenueTotals &totals = partial[keys[row]];
+                    totals.tickets++;
+                    totals.revenue.add(prices[row]);
+                }
+            },
+            [](vector<RevenueTotals> &result, const vector<RevenueTotals> &other)
+            {
+                for (size_t i = 0; i < result.size(); i++)
+                {
+                    result[i].tickets += other[i].tickets;
+                    result[i].revenue.add(other[i].revenue);
+                }
+            });
+    }
+}
+
+int countPassengersOnShip(const VoyageTable &voyages, const ShipInventory &inventory, string_view shipName)
+{
+    METRIC_TIMER(CountPassengersOnShip);
+    int count = 0;
+    for (uint32_t voyageId : voyages.shipVoyages(internPool().find(shipName)))
+    {
+        count += inventory.passengersOnVoyage(voyageId);
+    }
+    if (count == 0)
+    {
+        cout << "No tickets have been created for the ship " << shipName << "." << endl;
+    }
+    return count;
+}
+
+vector<string_view> getUniqueShipNames(const TicketTable &tickets)
+{
+    METRIC_TIMER(UniqueShipNames);
+    //       :   '
+    //      ,   
+    const uint32_t *ships = tickets.shipColumn();
+    vector<uint32_t> firstRows = parallelAggregate(
+        tickets.size(), vector<uint32_t>(internPool().size(), UINT32_MAX),
+        [ships](vector<uint32_t> &first, size_t begin, size_t end)
+        {
+            for (size_t row = begin; row < end; row++)
+            {
+                first[ships[row]] = min(first[ships[row]], static_cast<uint32_t>(row));
+            }
+        },
+        [](vector<uint32_t> &result, const vector<uint32_t> &other)
+        {
+            for (size_t i = 0; i < result.size(); i++)
+            {
+                result[i] = min(result[i], other[i]);
+            }
+        });
+
+    vector<pair<uint32_t, uint32_t>> order; // ( , )
+    for (uint32_t ship = 0; ship < firstRows.size(); ship++)
+    {
+        if (firstRows[ship] != UINT32_MAX)
+        {
+            order.emplace_back(firstRows[ship], ship);
+        }
+    }
+    sort(order.begin(), order.end());
+
+    vector<string_view> uniqueShipNames;
+    uniqueShipNames.reserve(order.size());
+    for (const auto &entry : order)
+    {
+        uniqueShipNames.push_back(internPool().view(entry.second));
+    }
+    return uniqueShipNames;
+}
+
+vector<int> getMostPopularCabinClasses(const TicketTable &tickets)
+{
+    METRIC_TIMER(PopularCabinClasses);
+    if (tickets.empty())
+    {
+        cout << "No tickets found." << endl;
+        return vector<int>();
+    }
+    return tickets.aggregate().mostPopularCabinClasses();
+}
+
+double calculateTotalRevenue(const TicketTable &tickets)
+{
+    METRIC_TIMER(TotalRevenue);
+    if (tickets.empty())
+    {
+        cout << "No tickets found." << endl;
+        return 0.0;
+    }
+    return tickets.aggregate().revenue();
+}
+
+int countPassengers(const PassengerRegistry &passengers)
+{
+    METRIC_TIMER(CountPassengers);
+    return static_cast<int>(passengers.size());
+}
+
+vector<string_view> getMostPopularDestinationPorts(const TicketTable &tickets)
+{
+    METRIC_TIMER(PopularDestinations);
+    vector<string_view> mostPopularDestinationPorts;
+    if (tickets.empty())
+    {
+        cout << "No tickets found." << endl;
+        return mostPopularDestinationPorts;
+    }
+    for (uint32_t id : tickets.aggregate().mostPopularDestinations())
+    {
+        mostPopularDestinationPorts.push_back(internPool().view(id));
+    }
+    //   ,   
+    sort(mostPopularDestinationPorts.begin(), mostPopularDestinationPorts.end());
+    return mostPopularDestinationPorts;
+}
+
+vector<uint32_t> getDeparturesBetween(const VoyageTable &voyages, uint32_t from, uint32_t to)
+{
+    METRIC_TIMER(DeparturesBetween);
+    vector<uint32_t> departures;
+    const DateIndex &index = voyages.byDate();
+    for (const DateIndex::Entry *entry = index.lowerBound(from), *last = index.upperBound(to); entry < last; entry++)
+    {
+        departures.push_back(entry->key);
+    }
+    return departures;
+}
+
+double calculateRevenueBetween(const TicketTable &tickets, uint32_t from, uint32_t to)
+{
+    METRIC_TIMER(RevenueBetween);
+    //     :     
+    const DateIndex &index = tickets.ticketsByDate();
+    const DateIndex::Entry *first = index.lowerBound(from);
+    size_t count = static_cast<size_t>(index.upperBound(to) - first);
+    const double *prices = tickets.priceColumn();
+
+    //          , 
+    //     ,    
+    vector<CompensatedSum> morselSums((count + morselRows - 1) / morselRows);
+    threadPool().parallelFor(count, morselRows, [&](size_t, size_t begin, size_t end)
+                             {
+                                 CompensatedSum sum;
+                                 for (size_t i = begin; i < end; i++)
+                                 {
+                                     sum.add(prices[first[i].key]);
+                                 }
+                                 morselSums[begin / morselRows] = sum;
+                             });
+    CompensatedSum revenue;
+    for (const CompensatedSum &sum : morselSums)
+    {
+        revenue.add(sum);
+    }
+    return revenue.value();
+}
+
+vector<ShipSummary> getShipReport(const TicketTable &tickets)
+{
+    METRIC_TIMER(ShipReport);
+    vector<RevenueTotals> totals = totalsBy(tickets.shipColumn(), tickets.priceColumn(), tickets.size(), internPool().size());
+
+    vector<ShipSummary> report;
+    for (uint32_t ship = 0; ship < totals.size(); ship++)
+    {
+        if (totals[ship].tickets > 0)
+        {
+            report.push_back(ShipSummary{ship, totals[ship].tickets, totals[ship].revenue.value()});
+        }
+    }
+    return report;
+}
+
+vector<VoyageSummary> getVoyageReport(const TicketTable &tickets, const VoyageTable &voyages)
+{
+    METRIC_TIMER(VoyageReport);
+    vector<RevenueTotals> totals = totalsBy(tickets.voyageColumn(), tickets.priceColumn(), tickets.size(), voyages.size());
+    vector<VoyageSummary> report;
+    for (uint32_t voyageId = 0; voyageId < totals.size(); voyageId++)
+    {
+        if (totals[voyageId].tickets > 0)
+        {
+            report.push_back(VoyageSummary{voyageId, totals[voyageId].tickets, totals[voyageId].revenue.value()});
+        }
+    }
+    return report;
+}
+
+TopKResult getTopDestinations(const TicketTable &tickets, bool routes, size_t k)
+{
+    METRIC_TIMER(TopDestinations);
+    const TicketPopularity &popularity = tickets.popularity();
+    return routes ? popularity.routes().top(k) : popularity.destinations().top(k);
+}
+
+TopKResult getTopDestinations(const TicketTable &tickets, bool routes, size_t k, uint32_t from, uint32_t to)
+{
+    METRIC_TIMER(TopDestinationsBetween);
+    const TicketPopularity &popularity = tickets.popularity();
+    return routes ? popularity.routes().top(k, from, to) : popularity.destinations().top(k, from, to);
+}
+
+void printTopK(ostream &out, const TopKResult &result, bool routes)
+{
+    if (result.items.empty())
+    {
+        out << "No tickets found." << '\n';
+        return;
+    }
+    size_t place = 1;
+    for (const TopKItem &item : result.items)
+    {
+        out << place++ << ". ";
+        if (routes)
+        {
+            out << internPool().view(TicketPopularity::routeDeparture(item.key)) << " -> "
+                << internPool().view(TicketPopularity::routeDestination(item.key));
+        }
+        else
+        {
+            out << internPool().view(static_cast<uint32_t>(item.key));
+        }
+        out << ": " << item.count;
+        if (item.lowerBound != item.upperBound)
+        {
+            out << " (between " << item.lowerBound << " and " << item.upperBound << ")";
+        }
+        out << '\n';
+    }
+    if (!result.exact)
+    {
+        out << "Approximate counts over " << result.total << " tickets, maximum error " << result.maxError
+            << " (probably at most " << min(result.maxError, result.probableError) << ")." << '\n';
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "PassengerRegistry.h"
+#include "ShipInventory.h"
+#include "TicketTable.h"
+#include "VoyageTable.h"
+
+//    (  ,    ).
+// ,        TicketTable  
+// ; ,     ,   
+//   threadPool().    string_view  internPool().
+
+//      (  ShipInventory,    )
+int countPassengersOnShip(const VoyageTable &voyages, const ShipInventory &inventory, std::string_view shipName);
+std::vector<std::string_view> getUniqueShipNames(const TicketTable &tickets);
+std::vector<int> getMostPopularCabinClasses(const TicketTable &tickets);
+double calculateTotalRevenue(const TicketTable &tickets);
+int countPassengers(const PassengerRegistry &passengers);
+std::vector<std::string_view> getMostPopularDestinationPorts(const TicketTable &tickets);
+
+//       (  )    internPool()
+struct ShipSummary
+{
+    uint32_t shipId;
+    size_t tickets;
+    double revenue;
+};
+std::vector<ShipSummary> getShipReport(const TicketTable &tickets);
+
+//       (  )    
+struct VoyageSummary
+{
+    uint32_t voyageId;
+    size_t tickets;
+    double revenue;
+};
+std::vector<VoyageSummary> getVoyageReport(const TicketTable &tickets, const VoyageTable &voyages);
+
+//      (routes = true)  
+//  TicketTable;    -       
+TopKResult getTopDestinations(const TicketTable &tickets, bool routes, size_t k);
+TopKResult getTopDestinations(const TicketTable &tickets, bool routes, size_t k, uint32_t from, uint32_t to);
+
+//   top-K      
+void printTopK(std::ostream &out, const TopKResult &result, bool routes);
+
+//    ( ,  )   :
+//              
+std::vector<uint32_t> getDeparturesBetween(const VoyageTable &voyages, uint32_t from, uint32_t to);
+double calculateRevenueBetween(const TicketTable &tickets, uint32_t from, uint32_t to);
@@ -0,0 +1,261 @@
+#include "BackgroundJournal.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+#include "Metrics.h"
+
+using namespace std;
+
+BackgroundJournal::BackgroundJournal(Journal &journal, const BackgroundJournalOptions &options)
+    : journal(journal), options(options), head(&stub), tail(&stub), lastSequence(0), processedSequence(0),
+      writtenSequence(0), durableSequence(0), writeFailed(false), stopping(false), stopped(false), sleeping(false)
+{
+    this->options.batchSize = max<size_t>(this->options.batchSize, 1);
+    this->options.highWatermark = max<size_t>(this->options.highWatermark, 1);
+    this->options.lowWatermark = min(this->options.lowWatermark, this->options.highWatermark - 1);
+    worker = thread(&BackgroundJournal::run, this);
+}
+
+BackgroundJournal::~BackgroundJournal()
+{
+    stop();
+}
+
+void BackgroundJournal::push(Node *node)
+{
+    node->next.store(nullptr);
+    Node *previous = head.exchange(node);
+    // ̳       ; pop  
+    previous->next.store(node);
+}
+
+BackgroundJournal::Node *BackgroundJournal::pop()
+{
+    Node *first = tail;
+    Node *next = first->next.load();
+    if (first == &stub)
+    {
+        if (next == nullptr)
+        {
+            return nullptr;
+        }
+        tail = next;
+        first = next;
+        next = next->next.load();
+    }
+    if (next != nullptr)
+    {
+        tail = next;
+        return first;
+    }
+    if (first != head.load())
+    {
+        return nullptr; //        
+    }
+    //     ,     stub
+    push(&stub);
+    next = first->next.load();
+    if (next != nullptr)
+    {
+        tail = next;
+        return first;
+    }
+    return nullptr;
+}
+
+bool BackgroundJournal::queueEmpty() const
+{
+    return tail == &stub && tail->next.load() == nullptr;
+}
+
+uint64_t BackgroundJournal::submitPassenger(const Passenger &passenger)
+{
+    Node *node = new Node;
+    journal.encodePassenger(node->record, passenger);
+    return submit(node);
+}
+
+uint64_t BackgroundJournal::submitReservation(const Passenger &passenger, const TicketTable &tickets, uint32_t row)
+{
+    Node *node = new Node;
+    journal.encodeReservation(node->record, passenger, tickets.fields(row));
+    return submit(node);
+}
+
+uint64_t BackgroundJournal::submit(Node *node)
+{
+    if (stopping.load())
+    {
+        delete node;
+        return 0;
+    }
+    uint64_t sequence = ++lastSequence;
+    node->sequence = sequence;
+    push(node);
+    if (sleeping.load())
+    {
+        lock_guard<mutex> guard(wakeLock);
+        wake.notify_one();
+    }
+
+    //  :     ,   
+    // .   ,    written()  .
+    if (sequence - processedSequence.load() >= options.highWatermark)
+    {
+        METRIC_COUNT(BackpressureWaits, 1);
+        waitProcessed(sequence - options.lowWatermark);
+    }
+    return sequence;
+}
+
+void BackgroundJournal::waitProcessed(uint64_t sequence)
+{
+    unique_lock<mutex> guard(progressLock);
+    progress.wait(guard, [&]
+                  { return processedSequence.load() >= sequence || stopped.load(); });
+}
+
+bool BackgroundJournal::waitDurable(uint64_t sequence)
+{
+    unique_lock<mutex> guard(progressLock);
+    progress.wait(guard, [&]
+                  { return durableSequence.load() >= sequence || writeFailed.load() || stopped.load(); });
+    return durableSequence.load() >= sequence;
+}
+
+bool BackgroundJournal::flush()
+{
+    waitProcessed(lastSequence.load());
+    lock_guard<mutex> guard(journalLock);
+    journal.sync();
+    return !writeFailed.load();
+}
+
+bool BackgroundJournal::compactIfNeeded(const PassengerRegistry &passengers, const TicketTable &tickets,
+                                        const VoyageTable &voyages)
+{
+    {
+        lock_guard<mutex> guard(journalLock);
+        if (!journal.needsCompaction() && !writeFailed.load())
+        {
+            return true;
+        }
+    }
+    //       ;      
+    uint64_t sequence = lastSequence.load();
+    waitProcessed(sequence);
+    lock_guard<mutex> guard(journalLock);
+    if (!journal.compact(passengers, tickets, voyages))
+    {
+        return false;
+    }
+    //    ,       sequence, 
+    // ,    ,    
+    {
+        lock_guard<mutex> progressGuard(progressLock);
+        writeFailed.store(false);
+        writtenSequence.store(max(writtenSequence.load(), sequence));
+        durableSequence.store(max(durableSequence.load(), sequence));
+    }
+    progress.notify_all();
+    return true;
+}
+
+bool BackgroundJournal::stop()
+{
+    if (!worker.joinable())
+    {
+        return !writeFailed.load();
+    }
+    stopping.store(true);
+    {
+        lock_guard<mutex> guard(wakeLock);
+        wake.notify_one();
+    }
+    worker.join();
+    {
+        lock_guard<mutex> guard(progressLock);
+        stopped.store(true);
+    }
+    progress.notify_all();
+    return !writeFailed.load();
+}
+
+void BackgroundJournal::run()
+{
+    vector<JournalRecord> batch;
+    vector<uint64_t> sequences;
+    // ,     (    
+    //     ); processed()    
+    priority_queue<uint64_t, vector<uint64_t>, greater<uint64_t>> ahead;
+    uint64_t contiguous = 0;
+
+    while (true)
+    {
+        batch.clear();
+        sequences.clear();
+        while (batch.size() < options.batchSize)
+        {
+            Node *node = pop();
+            if (node == nullptr)
+            {
+                break;
+            }
+            batch.push_back(move(node->record));
+            sequences.push_back(node->sequence);
+            delete node;
+        }
+
+        if (batch.empty())
+        {
+            //  :   stop,     
+            if (stopping.load() && queueEmpty() && head.load() == &stub)
+            {
+                break;
+            }
+            unique_lock<mutex> guard(wakeLock);
+            sleeping.store(true);
+            wake.wait(guard, [this]
+                      { return !queueEmpty() || stopping.load(); });
+            sleeping.store(false);
+            continue;
+        }
+
+        bool ok;
+        {
+            lock_guard<mutex> guard(journalLock);
+            ok = journal.append(batch.data(), batch.size()) && journal.commit(journal.lastLsn());
+        }
+        for (uint64_t sequence : sequences)
+        {
+            ahead.push(sequence);
+        }
+        while (!ahead.empty() && ahead.top() == contiguous + 1)
+        {
+            ahead.pop();
+            contiguous++;
+        }
+        {
+            // ϳ  written()  durable()   
+            //   ,  compactIfNeeded   
+            lock_guard<mutex> guard(progressLock);
+            if (!ok)
+            {
+                writeFailed.store(true);
+            }
+            processedSequence.store(contiguous);
+            if (!writeFailed.load())
+            {
+                writtenSequence.store(contiguous);
+                durableSequence.store(contiguous);
+            }
+        }
+        progress.notify_all();
+    }
+
+    //      ,   
+    lock_guard<mutex> guard(journalLock);
+    journal.sync();
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Models.h"
+#include "PassengerRegistry.h"
+#include "Persistence.h"
+#include "TicketTable.h"
+#include "VoyageTable.h"
+
+//    
+struct BackgroundJournalOptions
+{
+    size_t batchSize = 256;      //     
+    size_t highWatermark = 8192; //    -   ,
+    size_t lowWatermark = 2048;  //     
+};
+
+//      .    
+// (Journal::encodePassenger/encodeReservation)      
+//  (      ), 
+//     ,     
+// Journal::append    Journal::commit -  fsync  .
+//     (   submit);   
+// : written() -       , durable() -
+//    fsync .     
+//  .     highWatermark, submit
+// ,    lowWatermark,      , 
+//   .
+//   ,      .
+class BackgroundJournal
+{
+public:
+    explicit BackgroundJournal(Journal &journal, const BackgroundJournalOptions &options = BackgroundJournalOptions());
+    ~BackgroundJournal();
+
+    BackgroundJournal(const BackgroundJournal &) = delete;
+    BackgroundJournal &operator=(const BackgroundJournal &) = delete;
+
+    //    ;    (0  stop)
+    uint64_t submitPassenger(const Passenger &passenger);
+    uint64_t submitReservation(const Passenger &passenger, const TicketTable &tickets, uint32_t row);
+
+    uint64_t submitted() const { return lastSequence.load(); }
+    uint64_t processed() const { return processedSequence.load(); } //    
+    uint64_t written() const { return writtenSequence.load(); }
+    uint64_t durable() const { return durableSequence.load(); }
+
+    //       ; durable()    ,
+    //  compactIfNeeded     
+    bool failed() const { return writeFailed.load(); }
+
+    //    sequence; false,    
+    bool waitDurable(uint64_t sequence);
+
+    //  񳺿      (Journal::sync)
+    bool flush();
+
+    // ,         ( 
+    // 񳺿 );     ,    
+    // ,   
+    bool compactIfNeeded(const PassengerRegistry &passengers, const TicketTable &tickets,
+                         const VoyageTable &voyages);
+
+    //  񳺿    ;      
+    bool stop();
+
+private:
+    struct Node
+    {
+        std::atomic<Node *> next{nullptr};
+        uint64_t sequence = 0;
+        JournalRecord record;
+    };
+
+    Journal &journal;
+    BackgroundJournalOptions options;
+
+    // :    head ,    tail
+    std::atomic<Node *> head;
+    Node *tail;
+    Node stub;
+
+    std::atomic<uint64_t> lastSequence;
+    std::atomic<uint64_t> processedSequence;
+    std::atomic<uint64_t> writtenSequence;
+    std::atomic<uint64_t> durableSequence;
+    std::atomic<bool> writeFailed;
+    std::atomic<bool> stopping;
+    std::atomic<bool> stopped;
+
+    std::mutex journalLock; //  ,   
+    std::mutex wakeLock;
+    std::condition_variable wake; //     
+    std::atomic<bool> sleeping;
+    std::mutex progressLock;
+    std::condition_variable progress; //  processed(), written()  durable()
+
+    std::thread worker;
+
+    uint64_t submit(Node *node);
+    void push(Node *node);
+    Node *pop();
+    bool queueEmpty() const;
+    void run();
+
+    // ,  processed()  sequence
+    void waitProcessed(uint64_t sequence);
+};
@@ -0,0 +1,799 @@
+#include "BatchRunner.h"
+
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "Analytics.h"
+#include "InternPool.h"
+#include "MappedFile.h"
+#include "Metrics.h"
+#include "RouteSearch.h"
+#include "Validation.h"
+
+using namespace std;
+
+namespace
+{
+    const size_t maxTokens = 12;
+
+    //        ;   
+    //   .     .
+    size_t tokenize(string_view line, string_view *tokens, bool &unterminatedQuote)
+    {
+        size_t count = 0;
+        size_t i = 0;
+        unterminatedQuote = false;
+        while (i < line.size())
+        {
+            while (i < line.size() && (line[i] == ' ' || line[i] == '\t'))
+            {
+                i++;
+            }
+            if (i >= line.size())
+            {
+                break;
+            }
+            size_t start;
+            size_t end;
+            if (line[i] == '"')
+            {
+                start = ++i;
+                size_t quote = line.find('"', start);
+                if (quote == string_view::npos)
+                {
+                    unterminatedQuote = true;
+                    return count;
+                }
+                end = quote;
+                i = quote + 1;
+            }
+            else
+            {
+                start = i;
+                while (i < line.size() && line[i] != ' ' && line[i] != '\t')
+                {
+                    i++;
+                }
+                end = i;
+            }
+            if (count == maxTokens)
+            {
+                return count + 1; //  
+            }
+            tokens[count++] = line.substr(start, end - start);
+        }
+        return count;
+    }
+
+    bool parseInt(string_view text, int &value)
+    {
+        const char *end = text.data() + text.size();
+        from_chars_result result = from_chars(text.data(), end, value);
+        return !text.empty() && result.ec == errc() && result.ptr == end;
+    }
+
+    bool parseDouble(string_view text, double &value)
+    {
+        const char *end = text.data() + text.size();
+        from_chars_result result = from_chars(text.data(), end, value);
+        return !text.empty() && result.ec == errc() && result.ptr == end;
+    }
+
+    class BatchExecutor
+    {
+    public:
+        BatchExecutor(BookingState &state, Journal *journal, ostream &out, ostream &errors)
+            : state(state), journal(journal), out(out), errors(errors) {}
+
+        void execute(string_view line, BatchStats &stats)
+        {
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.remove_suffix(1);
+            }
+            string_view tokens[maxTokens];
+            bool unterminatedQuote;
+            size_t count = tokenize(line, tokens, unterminatedQuote);
+            if (count == 0 && !unterminatedQuote)
+            {
+                return;
+            }
+            if (count > 0 && tokens[0].size() > 0 && tokens[0][0] == '#')
+            {
+                return;
+            }
+
+            stats.commands++;
+            bool ok;
+            if (unterminatedQuote)
+            {
+                ok = fail(stats.lines, "Unterminated quote.");
+            }
+            else if (count > maxTokens)
+            {
+                ok = fail(stats.lines, "Too many arguments.");
+            }
+            else if (tokens[0] == "passenger")
+            {
+                ok = passengerCommand(tokens, count, stats.lines);
+            }
+            else if (tokens[0] == "ticket")
+            {
+                ok = ticketCommand(tokens, count, stats.lines);
+            }
+            else if (tokens[0] == "query")
+            {
+                ok = queryCommand(tokens, count, stats.lines);
+            }
+            else if (tokens[0] == "layout")
+            {
+                ok = layoutCommand(tokens, count, stats.lines);
+            }
+            else
+            {
+                errors << "line " << stats.lines << ": Unknown command '" << tokens[0] << "'." << '\n';
+                ok = false;
+            }
+            if (ok)
+            {
+                stats.succeeded++;
+            }
+            else
+            {
+                stats.failed++;
+            }
+        }
+
+    private:
+        BookingState &state;
+        Journal *journal;
+        ostream &out;
+        ostream &errors;
+        // ,     
+        string name, address, phoneNumber, dateText;
+        vector<Sailing> sailings;
+        vector<size_t> offsets;
+        TicketRequest request;
+
+        bool fail(size_t line, const char *message)
+        {
+            errors << "line " << line << ": " << message << '\n';
+            return false;
+        }
+
+        // ϳ   ; false (  ), 
+        //   .      ' (
+        // NotDurable)        , 
+        //  ID     .   
+        //    :      
+        // ,        
+        // (   compactionMinRecords  
+        //    )
+        bool persisted(size_t line)
+        {
+            if (journal == nullptr)
+            {
+                return true;
+            }
+            bool ok = true;
+            if (!journal->commit(journal->lastLsn()))
+            {
+                ok = fail(line, "Error writing to the data files.");
+            }
+            if (journal->textExportFailed())
+            {
+                //      ;    
+                errors << "line " << line << ": Warning: error writing the text data files.\n";
+                if (!journal->compact(state.passengers, state.tickets, state.voyages))
+                {
+                    ok = fail(line, "Error compacting the data files.");
+                }
+            }
+            return ok;
+        }
+
+        // ID   ,  "auto",   ID  used
+        bool parseId(string_view token, const IdRegistry &used, int &id)
+        {
+            if (token == "auto")
+            {
+                id = used.nextId(state.idAllocation);
+                return true;
+            }
+            return parseInt(token, id);
+        }
+
+        bool passengerCommand(const string_view *tokens, size_t count, size_t line)
+        {
+            int id;
+            if (count != 5)
+            {
+                return fail(line, "Expected: passenger <id>|auto <phone> <name> <address>");
+            }
+            if (!parseId(tokens[1], state.usedIds, id))
+            {
+                return fail(line, describeBookingStatus(BookingStatus::InvalidPassengerId));
+            }
+            phoneNumber.assign(tokens[2]);
+            name.assign(tokens[3]);
+            address.assign(tokens[4]);
+
+            BookingStatus status = createPassenger(state, name, address, phoneNumber, id, nullptr, journal);
+            if (status != BookingStatus::Ok)
+            {
+                return fail(line, describeBookingStatus(status));
+            }
+            if (!persisted(line))
+            {
+                return false;
+            }
+            if (tokens[1] == "auto")
+            {
+                out << "Passenger ID: " << id << '\n';
+            }
+            return true;
+        }
+
+        bool ticketCommand(const string_view *tokens, size_t count, size_t line)
+        {
+            const char *usage = "Expected: ticket <passengerId> <ticketId>|auto <ship> <class> <price> [<departure> <destination> <date>] [<cabin>]";
+            if (count != 6 && count != 7 && count != 9 && count != 10)
+            {
+                return fail(line, usage);
+            }
+            if (!parseInt(tokens[1], request.passengerId))
+            {
+                return fail(line, describeBookingStatus(BookingStatus::PassengerNotFound));
+            }
+            if (!parseId(tokens[2], state.usedTicketIds, request.ticketId))
+            {
+                return fail(line, describeBookingStatus(BookingStatus::InvalidTicketId));
+            }
+            request.shipName.assign(tokens[3]);
+            if (!parseInt(tokens[4], request.cabinClass))
+            {
+                return fail(line, describeBookingStatus(BookingStatus::InvalidCabinClass));
+            }
+            if (!parseDouble(tokens[5], request.price))
+            {
+                return fail(line, describeBookingStatus(BookingStatus::InvalidPrice));
+            }
+            // '   -  .    - 
+            //   (   ),    
+            int cabin = 0;
+            if (count == 7 || count == 10)
+            {
+                if (!parseInt(tokens[count - 1], cabin))
+                {
+                    return fail(line, usage);
+                }
+                if (cabin < 1)
+                {
+                    return fail(line, describeBookingStatus(BookingStatus::InvalidCabin));
+                }
+            }
+            request.cabin = static_cast<uint32_t>(cabin);
+            if (count >= 9)
+            {
+                request.departurePort.assign(tokens[6]);
+                request.destinationPort.assign(tokens[7]);
+                request.date.assign(tokens[8]);
+            }
+            else
+            {
+                request.departurePort.clear();
+                request.destinationPort.clear();
+                request.date.clear();
+            }
+
+            BookingStatus status = issueTicket(state, request, nullptr, journal);
+            if (status != BookingStatus::Ok)
+            {
+                return fail(line, describeBookingStatus(status));
+            }
+            if (!persisted(line))
+            {
+                return false;
+            }
+            if (tokens[2] == "auto")
+            {
+                out << "Ticket ID: " << request.ticketId << '\n';
+            }
+            return true;
+        }
+
+        // query departures|revenue <from> <to>:    
+        bool dateRangeQuery(const string_view *tokens, size_t line)
+        {
+            Date from, to;
+            if (!parseStoredDate(tokens[2], from) || !parseStoredDate(tokens[3], to))
+            {
+                return fail(line, "Invalid date range (expected dd/mm/yy dd/mm/yy).");
+            }
+            if (tokens[1] == "revenue")
+            {
+                out << "Revenue " << tokens[2] << " - " << tokens[3] << ": $"
+                    << calculateRevenueBetween(state.tickets, packDate(from), packDate(to)) << '\n';
+            }
+            else if (tokens[1] == "departures")
+            {
+                out << "Departures " << tokens[2] << " - " << tokens[3] << ":";
+                for (uint32_t voyageId : getDeparturesBetween(state.voyages, packDate(from), packDate(to)))
+                {
+                    const Voyage &voyage = state.voyages.voyage(voyageId);
+                    dateText.clear();
+                    formatDate(dateText, voyage.date);
+                    out << ' ' << internPool().view(voyage.shipId) << " (" << dateText << ')';
+                }
+                out << '\n';
+            }
+            else
+            {
+                return fail(line, "Unknown date query (expected departures or revenue).");
+            }
+            return true;
+        }
+
+        // query top destinations|routes <k> [<from> <to>]
+        bool topQuery(const string_view *tokens, size_t count, size_t line)
+        {
+            int k;
+            if ((count != 4 && count != 6) || (tokens[2] != "destinations" && tokens[2] != "routes") ||
+                !parseInt(tokens[3], k) || k < 1)
+            {
+                return fail(line, "Expected: query top destinations|routes <k> [<from> <to>]");
+            }
+            bool routes = tokens[2] == "routes";
+            TopKResult result;
+            if (count == 6)
+            {
+                Date from, to;
+                if (!parseStoredDate(tokens[4], from) || !parseStoredDate(tokens[5], to))
+                {
+                    return fail(line, "Invalid date range (expected dd/mm/yy dd/mm/yy).");
+                }
+                result = getTopDestinations(state.tickets, routes, static_cast<size_t>(k), packDate(from), packDate(to));
+            }
+            else
+            {
+                result = getTopDestinations(state.tickets, routes, static_cast<size_t>(k));
+            }
+            out << (routes ? "Top routes:" : "Top destination ports:") << '\n';
+            printTopK(out, result, routes);
+            return true;
+        }
+
+        // layout <ship> <economy> <business> <first>:   
+        bool layoutCommand(const string_view *tokens, size_t count, size_t line)
+        {
+            CabinLayout layout = {};
+            bool valid = count == 2 + cabinClassCount;
+            for (int i = 0; i < cabinClassCount && valid; i++)
+            {
+                int cabins = 0;
+                valid = parseInt(tokens[2 + i], cabins) && cabins >= 0;
+                layout.cabins[i] = static_cast<uint32_t>(cabins);
+            }
+            if (!valid || !layout.isValid())
+            {
+                return fail(line, "Expected: layout <ship> <economy> <business> <first> (up to 65535 cabins in total)");
+            }
+            uint32_t shipId = internPool().intern(tokens[1]);
+            if (!configureShipLayout(state, shipId, layout))
+            {
+                return fail(line, "The ship already has tickets; its cabin layout cannot be changed.");
+            }
+            if (journal != nullptr && !journal->saveCabinLayouts(state.inventory))
+            {
+                return fail(line, "Error writing to the data files.");
+            }
+            return true;
+        }
+
+        // , ,  
+        void printVoyage(uint32_t voyageId, bool withShip)
+        {
+            const Voyage &voyage = state.voyages.voyage(voyageId);
+            dateText.clear();
+            formatDate(dateText, voyage.date);
+            if (withShip)
+            {
+                out << internPool().view(voyage.shipId) << ' ';
+            }
+            out << dateText << ' ' << internPool().view(voyage.departurePort) << " -> "
+                << internPool().view(voyage.destinationPort);
+        }
+
+        // query cabins <ship> [<date>]:        ;
+        //   -        
+        bool cabinsQuery(const string_view *tokens, size_t count, size_t line)
+        {
+            uint32_t shipId = internPool().find(tokens[2]);
+            const vector<uint32_t> &schedule = state.voyages.shipVoyages(shipId);
+            uint32_t voyageId = VoyageTable::npos;
+            if (count == 4)
+            {
+                Date date;
+                if (!parseStoredDate(tokens[3], date))
+                {
+                    return fail(line, describeBookingStatus(BookingStatus::InvalidDate));
+                }
+                voyageId = state.voyages.find(shipId, packDate(date));
+                if (voyageId == VoyageTable::npos)
+                {
+                    return fail(line, "The ship has no voyage on this date.");
+                }
+            }
+            else if (schedule.size() > 1)
+            {
+                return fail(line, describeBookingStatus(BookingStatus::VoyageRequired));
+            }
+            else if (!schedule.empty())
+            {
+                voyageId = schedule.front();
+            }
+
+            out << "Free cabins on ship " << tokens[2];
+            if (voyageId != VoyageTable::npos)
+            {
+                dateText.clear();
+                formatDate(dateText, state.voyages.voyage(voyageId).date);
+                out << " (" << dateText << ')';
+            }
+            out << ":";
+            CabinLayout layout = voyageId != VoyageTable::npos ? state.inventory.layout(voyageId) : state.inventory.shipLayout(shipId);
+            for (int cabinClass = 1; cabinClass <= cabinClassCount; cabinClass++)
+            {
+                uint32_t free = voyageId != VoyageTable::npos ? state.inventory.freeCabins(voyageId, cabinClass)
+                                                              : layout.cabins[cabinClass - 1];
+                out << ' ' << free << '/' << layout.cabins[cabinClass - 1];
+            }
+            out << '\n';
+            return true;
+        }
+
+        // query voyages <ship>:      
+        bool voyagesQuery(string_view shipName)
+        {
+            out << "Voyages of ship " << shipName << ":" << '\n';
+            for (uint32_t voyageId : findShipVoyages(state, shipName))
+            {
+                printVoyage(voyageId, false);
+                out << ": " << state.inventory.passengersOnVoyage(voyageId) << '/' << state.inventory.capacity(voyageId)
+                    << " passengers" << '\n';
+            }
+            return true;
+        }
+
+        // query phone <number>:     
+        bool phoneQuery(string_view phoneNumber, size_t line)
+        {
+            if (!isValidPhoneNumber(phoneNumber))
+            {
+                return fail(line, describeBookingStatus(BookingStatus::InvalidPhoneNumber));
+            }
+            const Passenger *passenger = state.passengers.findByPhone(phoneNumber);
+            if (passenger == nullptr)
+            {
+                out << "No passenger with phone " << phoneNumber << '\n';
+                return true;
+            }
+            out << "Passenger with phone " << phoneNumber << ": ID " << passenger->id << ", " << passenger->name << '\n';
+            return true;
+        }
+
+        // query name <prefix> [<limit>]: , '    prefix
+        bool nameQuery(const string_view *tokens, size_t count, size_t line)
+        {
+            int limit = 20;
+            if (count == 4 && (!parseInt(tokens[3], limit) || limit < 1))
+            {
+                return fail(line, "Limit must be a positive number.");
+            }
+            vector<const Passenger *> found;
+            size_t total = state.passengers.findByNamePrefix(tokens[2], static_cast<size_t>(limit), found);
+            out << "Passengers with name starting with '" << tokens[2] << "': " << total << '\n';
+            for (const Passenger *passenger : found)
+            {
+                out << "  ID " << passenger->id << ": " << passenger->name << ", " << passenger->phoneNumber << '\n';
+            }
+            return true;
+        }
+
+        //    : <departure> <destination> <date> [<to>]
+        bool parseRouteQuery(const string_view *tokens, size_t count, RouteQuery &query)
+        {
+            Date from, to;
+            if ((count != 3 && count != 4) || !parseStoredDate(tokens[2], from) ||
+                !parseStoredDate(tokens[count - 1], to))
+            {
+                return false;
+            }
+            query.departurePort = internPool().find(tokens[0]);
+            query.destinationPort = internPool().find(tokens[1]);
+            query.from = packDate(from);
+            query.to = packDate(to);
+            return true;
+        }
+
+        //  :        
+        void printSailings(const RouteQuery &query, string_view departure, string_view destination,
+                           const Sailing *first, const Sailing *last)
+        {
+            out << departure << " -> " << destination << ' ';
+            dateText.clear();
+            formatDate(dateText, query.from);
+            if (query.to != query.from)
+            {
+                dateText += " - ";
+                formatDate(dateText, query.to);
+            }
+            out << dateText << ":";
+            if (first == last)
+            {
+                out << " no sailings" << '\n';
+                return;
+            }
+            for (const Sailing *sailing = first; sailing < last; sailing++)
+            {
+                const Voyage &voyage = state.voyages.voyage(sailing->voyageId);
+                dateText.clear();
+                formatDate(dateText, voyage.date);
+                out << ' ' << internPool().view(voyage.shipId) << ' ' << dateText << " (";
+                CabinLayout layout = state.inventory.layout(sailing->voyageId);
+                for (int cabinClass = 1; cabinClass <= cabinClassCount; cabinClass++)
+                {
+                    out << (cabinClass > 1 ? " " : "") << sailing->freeCabins[cabinClass - 1] << '/' << layout.cabins[cabinClass - 1];
+                }
+                out << ')';
+            }
+            out << '\n';
+        }
+
+        // query route <departure> <destination> <date> [<to>]
+        bool routeQuery(const string_view *tokens, size_t count, size_t line)
+        {
+            RouteQuery query;
+            if (!parseRouteQuery(tokens + 2, count - 2, query))
+            {
+                return fail(line, "Expected: query route <departure> <destination> <date dd/mm/yy> [<to dd/mm/yy>]");
+            }
+            sailings.clear();
+            findSailings(state.voyages, state.inventory, query, sailings);
+            printSailings(query, tokens[2], tokens[3], sailings.data(), sailings.data() + sailings.size());
+            return true;
+        }
+
+        // query routes <file>:    (     
+        // query route    )   
+        bool routesQuery(string_view filename, size_t line)
+        {
+            MappedFile file;
+            if (!file.open(string(filename)))
+            {
+                return fail(line, "Error opening the route query file.");
+            }
+            vector<RouteQuery> queries;
+            vector<pair<string_view, string_view>> ports;
+            const char *current = file.data();
+            const char *end = current + file.size();
+            size_t queryLine = 0;
+            while (current < end)
+            {
+                const char *newline = static_cast<const char *>(memchr(current, '\n', static_cast<size_t>(end - current)));
+                const char *lineEnd = newline == nullptr ? end : newline;
+                string_view text(current, static_cast<size_t>(lineEnd - current));
+                current = lineEnd + 1;
+                queryLine++;
+                if (!text.empty() && text.back() == '\r')
+                {
+                    text.remove_suffix(1);
+                }
+                string_view tokens[maxTokens];
+                bool unterminatedQuote;
+                size_t count = tokenize(text, tokens, unterminatedQuote);
+                if (count == 0 && !unterminatedQuote)
+                {
+                    continue;
+                }
+                RouteQuery query;
+                if (unterminatedQuote || !parseRouteQuery(tokens, count, query))
+                {
+                    errors << "line " << line << ": route query " << queryLine << " is invalid." << '\n';
+                    continue;
+                }
+                queries.push_back(query);
+                ports.emplace_back(tokens[0], tokens[1]);
+            }
+
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            findSailings(state.voyages, state.inventory, queries, sailings, offsets);
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            for (size_t i = 0; i < queries.size(); i++)
+            {
+                printSailings(queries[i], ports[i].first, ports[i].second, sailings.data() + offsets[i],
+                              sailings.data() + offsets[i + 1]);
+            }
+            errors << "Route search: " << queries.size() << " queries, " << sailings.size() << " sailings in "
+                   << seconds << " s." << '\n';
+            return true;
+        }
+
+        bool queryCommand(const string_view *tokens, size_t count, size_t line)
+        {
+            if (count >= 2 && tokens[1] == "route")
+            {
+                return routeQuery(tokens, count, line);
+            }
+            if (count == 3 && tokens[1] == "routes")
+            {
+                return routesQuery(tokens[2], line);
+            }
+            if ((count == 3 || count == 4) && tokens[1] == "cabins")
+            {
+                return cabinsQuery(tokens, count, line);
+            }
+            if (count == 3 && tokens[1] == "voyages")
+            {
+                return voyagesQuery(tokens[2]);
+            }
+            if (count == 2 && tokens[1] == "metrics")
+            {
+                string text;
+                writePrometheusMetrics(text);
+                out << text;
+                return true;
+            }
+            if (count == 3 && tokens[1] == "phone")
+            {
+                return phoneQuery(tokens[2], line);
+            }
+            if ((count == 3 || count == 4) && tokens[1] == "name")
+            {
+                return nameQuery(tokens, count, line);
+            }
+            if (count == 3 && tokens[1] == "ship")
+            {
+                int passengers = 0;
+                for (uint32_t voyageId : findShipVoyages(state, tokens[2]))
+                {
+                    passengers += state.inventory.passengersOnVoyage(voyageId);
+                }
+                out << "Passengers on ship " << tokens[2] << ": " << passengers << '\n';
+                return true;
+            }
+            if (count >= 2 && tokens[1] == "top")
+            {
+                return topQuery(tokens, count, line);
+            }
+            if (count == 4)
+            {
+                return dateRangeQuery(tokens, line);
+            }
+            if (count != 2)
+            {
+                return fail(line, "Expected: query passengers|revenue|ships|classes|destinations|report|voyages|metrics, "
+                                  "query ship|voyages <name>, query cabins <name> [<date>], "
+                                  "query route <departure> <destination> <date> [<to>], query routes <file>, "
+                                  "query phone <number>, query name <prefix> [<limit>] "
+                                  "or query departures|revenue <from> <to>");
+            }
+            if (tokens[1] == "passengers")
+            {
+                out << "Total passengers: " << countPassengers(state.passengers) << '\n';
+            }
+            else if (tokens[1] == "revenue")
+            {
+                out << "Total revenue: $" << calculateTotalRevenue(state.tickets) << '\n';
+            }
+            else if (tokens[1] == "ships")
+            {
+                out << "Unique ship names:";
+                for (string_view ship : getUniqueShipNames(state.tickets))
+                {
+                    out << ' ' << ship;
+                }
+                out << '\n';
+            }
+            else if (tokens[1] == "classes")
+            {
+                out << "Most popular cabin class(es):";
+                for (int cabinClass : getMostPopularCabinClasses(state.tickets))
+                {
+                    out << ' ' << cabinClass;
+                }
+                out << '\n';
+            }
+            else if (tokens[1] == "destinations")
+            {
+                out << "Most popular destination port(s):";
+                for (string_view port : getMostPopularDestinationPorts(state.tickets))
+                {
+                    out << ' ' << port;
+                }
+                out << '\n';
+            }
+            else if (tokens[1] == "report")
+            {
+                out << "Revenue by ship:" << '\n';
+                for (const ShipSummary &ship : getShipReport(state.tickets))
+                {
+                    out << internPool().view(ship.shipId) << ": " << ship.tickets << " tickets, $" << ship.revenue << '\n';
+                }
+            }
+            else if (tokens[1] == "voyages")
+            {
+                out << "Revenue by voyage:" << '\n';
+                for (const VoyageSummary &voyage : getVoyageReport(state.tickets, state.voyages))
+                {
+                    printVoyage(voyage.voyageId, true);
+                    out << ": " << voyage.tickets << " tickets, $" << voyage.revenue << '\n';
+                }
+            }
+            else
+            {
+                errors << "line " << line << ": Unknown query '" << tokens[1] << "'." << '\n';
+                return false;
+            }
+            return true;
+        }
+    };
+}
+
+BatchStats runBatchCommands(const char *data, size_t size, BookingState &state, Journal *journal,
+                            ostream &out, ostream &errors)
+{
+    BatchStats stats;
+    BatchExecutor executor(state, journal, out, errors);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    const char *current = data;
+    const char *end = data + size;
+    while (current < end)
+    {
+        const char *newline = static_cast<const char *>(memchr(current, '\n', static_cast<size_t>(end - current)));
+        const char *lineEnd = newline == nullptr ? end : newline;
+        stats.lines++;
+        executor.execute(string_view(current, static_cast<size_t>(lineEnd - current)), stats);
+        current = lineEnd + 1;
+    }
+
+    stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+bool runBatchFile(const string &filename, BookingState &state, Journal *journal,
+                  ostream &out, ostream &errors, BatchStats &stats)
+{
+    if (filename != "-")
+    {
+        MappedFile file;
+        if (!file.open(filename))
+        {
+            return false;
+        }
+        stats = runBatchCommands(file.data(), file.size(), state, journal, out, errors);
+        return true;
+    }
+
+    //      
+    vector<char> input;
+    const size_t chunk = 1 << 20;
+    size_t used = 0;
+    while (true)
+    {
+        input.resize(used + chunk);
+        size_t read = fread(input.data() + used, 1, chunk, stdin);
+        used += read;
+        if (read < chunk)
+        {
+            break;
+        }
+    }
+    stats = runBatchCommands(input.data(), used, state, journal, out, errors);
+    return true;
+}
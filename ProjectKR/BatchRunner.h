@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+#include "Booking.h"
+#include "Persistence.h"
+
+// ϳ   
+struct BatchStats
+{
+    size_t lines = 0;
+    size_t commands = 0;
+    size_t succeeded = 0;
+    size_t failed = 0;
+    double seconds = 0.0;
+};
+
+//  :     ,     .
+//
+//   passenger <id>|auto <phone> <name> <address>
+//   ticket <passengerId> <ticketId>|auto <ship> <class> <price> [<departure> <destination> <date>] [<cabin>]
+//   layout <ship> <economy> <business> <first>
+//   query passengers|revenue|ships|classes|destinations|report|voyages
+//   query metrics   (      Prometheus)
+//   query ship|voyages <name>
+//   query cabins <ship> [<date dd/mm/yy>]
+//   query departures|revenue <from dd/mm/yy> <to dd/mm/yy>
+//   query top destinations|routes <k> [<from dd/mm/yy> <to dd/mm/yy>]
+//   query route <departure> <destination> <date dd/mm/yy> [<to dd/mm/yy>]
+//   query routes <file>   ( : <departure> <destination> <date> [<to>])
+//   query phone <+380xxxxxxxxx>
+//   query name <prefix> [<limit>]   ('   -  )
+//
+//  ID   auto:   ID  
+// state.idAllocation,   ID   out.
+//          ;   - 
+//      (    ).
+//       ("Kyiv, Main st. 1").   
+// ,    '#', .     errors
+//     ;     out.
+//      (  );  
+// ,  ,  .      ,
+//   ,     
+//   ;  ID   .
+BatchStats runBatchCommands(const char *data, size_t size, BookingState &state, Journal *journal,
+                            std::ostream &out, std::ostream &errors);
+
+//         (filename == "-")
+bool runBatchFile(const std::string &filename, BookingState &state, Journal *journal,
+                  std::ostream &out, std::ostream &errors, BatchStats &stats);
@@ -0,0 +1,355 @@
+#include "Booking.h"
+
+#include "InternPool.h"
+#include "Metrics.h"
+#include "Validation.h"
+
+using namespace std;
+
+const char *describeBookingStatus(BookingStatus status)
+{
+    switch (status)
+    {
+    case BookingStatus::Ok:
+        return "OK";
+    case BookingStatus::InvalidPassengerId:
+        return "Invalid passenger ID. ID must be greater than or equal to 1.";
+    case BookingStatus::DuplicatePassengerId:
+        return "Passenger ID is already in use.";
+    case BookingStatus::InvalidPhoneNumber:
+        return "Invalid phone number format. Expected +380xxxxxxxxx.";
+    case BookingStatus::DuplicatePhoneNumber:
+        return "A passenger with this phone number already exists.";
+    case BookingStatus::PassengerNotFound:
+        return "Passenger not found.";
+    case BookingStatus::PassengerHasTicket:
+        return "Passenger already has a ticket. Cannot add another ticket.";
+    case BookingStatus::ShipFull:
+        return "Cannot add a ticket. The ship is full.";
+    case BookingStatus::InvalidTicketId:
+        return "Invalid ticket ID. ID must be greater than or equal to 1.";
+    case BookingStatus::DuplicateTicketId:
+        return "Ticket ID is already in use.";
+    case BookingStatus::MissingRoute:
+        return "The ship has no voyage on this date yet. Departure port, destination port and date are required.";
+    case BookingStatus::VoyageRequired:
+        return "The ship has several voyages. Please specify the voyage date.";
+    case BookingStatus::RouteMismatch:
+        return "Route does not match the existing voyage of the ship on this date.";
+    case BookingStatus::SamePorts:
+        return "Destination port cannot be the same as departure port.";
+    case BookingStatus::InvalidDate:
+        return "Invalid date. Expected dd/mm/yy within the allowed booking years.";
+    case BookingStatus::InvalidCabinClass:
+        return "Invalid cabin class. Expected 1, 2 or 3.";
+    case BookingStatus::InvalidPrice:
+        return "Invalid price for the selected cabin class.";
+    case BookingStatus::CabinClassFull:
+        return "Cannot add a ticket. The selected cabin class is full.";
+    case BookingStatus::CabinTaken:
+        return "The selected cabin is already taken.";
+    case BookingStatus::InvalidCabin:
+        return "The ship has no cabin with this number in the selected cabin class.";
+    case BookingStatus::NotPersisted:
+        return "The record could not be saved to disk and was not added.";
+    case BookingStatus::NotDurable:
+        return "The record was added, but the disk did not confirm the write.";
+    }
+    return "Unknown error.";
+}
+
+bool isValidPrice(int cabinClass, double price)
+{
+    // ĳ :  51-249$,  251-499$,  501-999$
+    switch (cabinClass)
+    {
+    case 1:
+        return price > 50 && price < 250;
+    case 2:
+        return price > 250 && price < 500;
+    case 3:
+        return price > 500 && price < 1000;
+    default:
+        return false;
+    }
+}
+
+BookingStatus checkPassengerId(const BookingState &state, int id)
+{
+    if (id < 1)
+    {
+        return BookingStatus::InvalidPassengerId;
+    }
+    if (state.usedIds.contains(id))
+    {
+        return BookingStatus::DuplicatePassengerId;
+    }
+    return BookingStatus::Ok;
+}
+
+BookingStatus checkTicketId(const BookingState &state, int ticketId)
+{
+    if (ticketId < 1)
+    {
+        return BookingStatus::InvalidTicketId;
+    }
+    if (state.usedTicketIds.contains(ticketId))
+    {
+        return BookingStatus::DuplicateTicketId;
+    }
+    return BookingStatus::Ok;
+}
+
+BookingStatus findVoyage(const BookingState &state, const TicketRequest &request, uint32_t &voyageId)
+{
+    //      : ,    , 
+    //      
+    voyageId = VoyageTable::npos;
+    uint32_t shipId = internPool().find(request.shipName);
+    bool hasPorts = !request.departurePort.empty() || !request.destinationPort.empty();
+    if (request.date.empty())
+    {
+        const vector<uint32_t> &schedule = state.voyages.shipVoyages(shipId);
+        if (hasPorts || schedule.empty())
+        {
+            return BookingStatus::MissingRoute;
+        }
+        if (schedule.size() > 1)
+        {
+            return BookingStatus::VoyageRequired;
+        }
+        voyageId = schedule.front();
+        return BookingStatus::Ok;
+    }
+
+    Date date = {};
+    if (shipId != InternPool::npos && parseStoredDate(request.date, date))
+    {
+        voyageId = state.voyages.find(shipId, packDate(date));
+    }
+    if (voyageId != VoyageTable::npos)
+    {
+        const Voyage &voyage = state.voyages.voyage(voyageId);
+        if (hasPorts && (internPool().find(request.departurePort) != voyage.departurePort ||
+                         internPool().find(request.destinationPort) != voyage.destinationPort))
+        {
+            return BookingStatus::RouteMismatch;
+        }
+        return BookingStatus::Ok;
+    }
+
+    //  :       
+    if (request.departurePort.empty() || request.destinationPort.empty())
+    {
+        return BookingStatus::MissingRoute;
+    }
+    if (request.departurePort == request.destinationPort)
+    {
+        return BookingStatus::SamePorts;
+    }
+    if (!parseDate(request.date, date))
+    {
+        return BookingStatus::InvalidDate;
+    }
+    return BookingStatus::Ok;
+}
+
+uint32_t openVoyage(BookingState &state, const TicketRequest &request)
+{
+    Date date;
+    parseDate(request.date, date); //     findVoyage
+    uint32_t shipId = internPool().intern(request.shipName);
+    uint32_t voyageId = state.voyages.add(shipId, internPool().intern(request.departurePort),
+                                          internPool().intern(request.destinationPort), packDate(date));
+    state.inventory.openVoyage(voyageId, shipId);
+    return voyageId;
+}
+
+const vector<uint32_t> &findShipVoyages(const BookingState &state, string_view shipName)
+{
+    return state.voyages.shipVoyages(internPool().find(shipName));
+}
+
+bool configureShipLayout(BookingState &state, uint32_t shipId, const CabinLayout &layout)
+{
+    const vector<uint32_t> &schedule = state.voyages.shipVoyages(shipId);
+    for (uint32_t voyageId : schedule)
+    {
+        if (state.inventory.passengersOnVoyage(voyageId) != 0)
+        {
+            return false;
+        }
+    }
+    if (!state.inventory.setLayout(shipId, layout))
+    {
+        return false;
+    }
+    //      
+    for (uint32_t voyageId : schedule)
+    {
+        state.inventory.openVoyage(voyageId, shipId);
+    }
+    return true;
+}
+
+BookingStatus checkPassengerCanBook(const BookingState &state, int passengerId)
+{
+    const Passenger *passenger = state.passengers.find(passengerId);
+    if (passenger == nullptr)
+    {
+        return BookingStatus::PassengerNotFound;
+    }
+    if (!passenger->tickets.empty())
+    {
+        return BookingStatus::PassengerHasTicket;
+    }
+    return BookingStatus::Ok;
+}
+
+namespace
+{
+    BookingStatus tryCreatePassenger(BookingState &state, const string &name, const string &address,
+                                     const string &phoneNumber, int id, const Passenger **created, Journal *journal)
+    {
+        if (!isValidPhoneNumber(phoneNumber))
+        {
+            return BookingStatus::InvalidPhoneNumber;
+        }
+        BookingStatus status = checkPassengerId(state, id);
+        if (status != BookingStatus::Ok)
+        {
+            return status;
+        }
+        if (state.passengers.findByPhone(phoneNumber) != nullptr)
+        {
+            return BookingStatus::DuplicatePhoneNumber;
+        }
+        //  ,  :    '  '
+        Passenger candidate(name, address, phoneNumber, id);
+        if (journal != nullptr && !journal->appendPassenger(candidate))
+        {
+            return BookingStatus::NotPersisted;
+        }
+        Passenger *passenger = state.passengers.emplace(move(candidate.name), move(candidate.address),
+                                                        move(candidate.phoneNumber), id);
+        if (passenger == nullptr)
+        {
+            return BookingStatus::DuplicatePassengerId;
+        }
+        state.usedIds.insert(id);
+        if (created != nullptr)
+        {
+            *created = passenger;
+        }
+        return BookingStatus::Ok;
+    }
+
+    BookingStatus tryIssueTicket(BookingState &state, const TicketRequest &request, const Passenger **booked,
+                                 Journal *journal)
+    {
+        BookingStatus status = checkPassengerCanBook(state, request.passengerId);
+        if (status != BookingStatus::Ok)
+        {
+            return status;
+        }
+        status = checkTicketId(state, request.ticketId);
+        if (status != BookingStatus::Ok)
+        {
+            return status;
+        }
+
+        //  :      
+        uint32_t voyageId;
+        status = findVoyage(state, request, voyageId);
+        if (status != BookingStatus::Ok)
+        {
+            return status;
+        }
+        if (voyageId != VoyageTable::npos && state.inventory.isVoyageFull(voyageId))
+        {
+            return BookingStatus::ShipFull;
+        }
+
+        if (request.cabinClass < 1 || request.cabinClass > cabinClassCount)
+        {
+            return BookingStatus::InvalidCabinClass;
+        }
+        if (!isValidPrice(request.cabinClass, request.price))
+        {
+            return BookingStatus::InvalidPrice;
+        }
+        //      ,     
+        //   
+        CabinLayout layout = voyageId != VoyageTable::npos ? state.inventory.layout(voyageId)
+                                                           : state.inventory.shipLayout(internPool().find(request.shipName));
+        if (voyageId != VoyageTable::npos ? state.inventory.isClassFull(voyageId, request.cabinClass)
+                                          : layout.cabins[request.cabinClass - 1] == 0)
+        {
+            return BookingStatus::CabinClassFull;
+        }
+        if (request.cabin != 0)
+        {
+            if (layout.classOf(request.cabin) != request.cabinClass)
+            {
+                return BookingStatus::InvalidCabin;
+            }
+            if (voyageId != VoyageTable::npos && !state.inventory.isCabinFree(voyageId, request.cabin))
+            {
+                return BookingStatus::CabinTaken;
+            }
+        }
+
+        //        
+        if (voyageId == VoyageTable::npos)
+        {
+            voyageId = openVoyage(state, request);
+        }
+
+        // ̳    ,      
+        TicketFields ticket{request.ticketId, state.voyages.voyage(voyageId), request.cabinClass, 0, request.price};
+        state.inventory.tryReserve(voyageId, request.cabinClass, request.cabin, ticket.cabin);
+
+        //    -    ,    
+        Passenger *passenger = state.passengers.find(request.passengerId);
+        if (journal != nullptr && !journal->appendReservation(*passenger, ticket))
+        {
+            state.inventory.release(voyageId, request.cabinClass, ticket.cabin);
+            return BookingStatus::NotPersisted;
+        }
+
+        //         
+        state.usedTicketIds.insert(request.ticketId);
+        passenger->tickets.push_back(state.tickets.add(request.ticketId, voyageId, ticket.route, request.cabinClass,
+                                                       ticket.cabin, request.price));
+        if (booked != nullptr)
+        {
+            *booked = passenger;
+        }
+        return BookingStatus::Ok;
+    }
+}
+
+BookingStatus createPassenger(BookingState &state, const string &name, const string &address,
+                              const string &phoneNumber, int id, const Passenger **created, Journal *journal)
+{
+    METRIC_TIMER(CreatePassenger);
+    BookingStatus status = tryCreatePassenger(state, name, address, phoneNumber, id, created, journal);
+    if (status != BookingStatus::Ok)
+    {
+        METRIC_COUNT(BookingRejected, 1);
+    }
+    return status;
+}
+
+BookingStatus issueTicket(BookingState &state, const TicketRequest &request, const Passenger **booked,
+                          Journal *journal)
+{
+    METRIC_TIMER(IssueTicket);
+    BookingStatus status = tryIssueTicket(state, request, booked, journal);
+    if (status != BookingStatus::Ok)
+    {
+        METRIC_COUNT(BookingRejected, 1);
+    }
+    return status;
+}
+
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "IdRegistry.h"
+#include "Models.h"
+#include "PassengerRegistry.h"
+#include "Persistence.h"
+#include "ShipInventory.h"
+#include "TicketTable.h"
+#include "VoyageTable.h"
+
+//    ,       
+struct BookingState
+{
+    PassengerRegistry &passengers;
+    TicketTable &tickets;
+    IdRegistry &usedIds;
+    IdRegistry &usedTicketIds;
+    VoyageTable &voyages;
+    ShipInventory &inventory;
+    IdAllocation idAllocation = IdAllocation::Monotonic; //   ID,    
+};
+
+//    
+enum class BookingStatus
+{
+    Ok,
+    InvalidPassengerId,
+    DuplicatePassengerId,
+    InvalidPhoneNumber,
+    DuplicatePhoneNumber,
+    PassengerNotFound,
+    PassengerHasTicket,
+    ShipFull,
+    InvalidTicketId,
+    DuplicateTicketId,
+    MissingRoute,
+    VoyageRequired,
+    RouteMismatch,
+    SamePorts,
+    InvalidDate,
+    InvalidCabinClass,
+    InvalidPrice,
+    CabinClassFull,
+    CabinTaken,
+    InvalidCabin,
+    NotPersisted, //     ,    
+    NotDurable    //   ,      (fsync)
+};
+
+//    
+const char *describeBookingStatus(BookingStatus status);
+
+//   .     :    
+//    ,       , 
+//    .        .
+struct TicketRequest
+{
+    int passengerId = 0;
+    int ticketId = 0;
+    std::string shipName;
+    std::string departurePort;
+    std::string destinationPort;
+    std::string date;
+    int cabinClass = 0;
+    uint32_t cabin = 0; //  ; 0 -    
+    double price = 0.0;
+};
+
+//       
+bool isValidPrice(int cabinClass, double price);
+
+//   : voyageId -    VoyageTable::npos, 
+//     (     )
+BookingStatus findVoyage(const BookingState &state, const TicketRequest &request, uint32_t &voyageId);
+
+// ³     ,  findVoyage
+uint32_t openVoyage(BookingState &state, const TicketRequest &request);
+
+//     shipName   
+const std::vector<uint32_t> &findShipVoyages(const BookingState &state, std::string_view shipName);
+
+//    ,     ;
+// false,        
+bool configureShipLayout(BookingState &state, uint32_t shipId, const CabinLayout &layout);
+
+BookingStatus checkPassengerId(const BookingState &state, int id);
+BookingStatus checkTicketId(const BookingState &state, int ticketId);
+
+//      (      )
+BookingStatus checkPassengerCanBook(const BookingState &state, int passengerId);
+
+//      ,     .
+//   created    .   journal,
+//       ;    ,
+//    (NotPersisted).
+BookingStatus createPassenger(BookingState &state, const std::string &name, const std::string &address,
+                              const std::string &phoneNumber, int id, const Passenger **created,
+                              Journal *journal = nullptr);
+
+//      ,    .
+//   booked   ,   . journal -  
+// createPassenger:  NotPersisted  ,    
+// ( ,   ,  ).
+BookingStatus issueTicket(BookingState &state, const TicketRequest &request, const Passenger **booked,
+                          Journal *journal = nullptr);
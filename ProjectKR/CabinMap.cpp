@@ -0,0 +1,201 @@
+#include "CabinMap.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define PROJECTKR_SSE2 1
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+using namespace std;
+
+namespace
+{
+    //     (word != 0)
+    uint32_t lowestBit(uint64_t word)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<uint32_t>(index);
+#else
+        return static_cast<uint32_t>(__builtin_ctzll(word));
+#endif
+    }
+}
+
+uint32_t CabinLayout::total() const
+{
+    uint32_t sum = 0;
+    for (uint32_t count : cabins)
+    {
+        sum += count;
+    }
+    return sum;
+}
+
+uint32_t CabinLayout::firstCabin(int cabinClass) const
+{
+    uint32_t first = 1;
+    for (int i = 0; i < cabinClass - 1 && i < cabinClassCount; i++)
+    {
+        first += cabins[i];
+    }
+    return first;
+}
+
+int CabinLayout::classOf(uint32_t cabin) const
+{
+    uint32_t first = 1;
+    for (int i = 0; i < cabinClassCount; i++)
+    {
+        if (cabin >= first && cabin < first + cabins[i])
+        {
+            return i + 1;
+        }
+        first += cabins[i];
+    }
+    return 0;
+}
+
+bool CabinLayout::isValid() const
+{
+    for (uint32_t count : cabins)
+    {
+        if (count > maxCabinsPerClass)
+        {
+            return false;
+        }
+    }
+    return total() > 0 && total() <= maxCabinsPerClass;
+}
+
+void CabinBitmap::reset(uint32_t cabins)
+{
+    this->cabins = cabins;
+    wordCount = (cabins + 63) / 64;
+    if (wordCount > 1)
+    {
+        storage.reset(new atomic<uint64_t>[wordCount]);
+        words = storage.get();
+    }
+    else
+    {
+        storage.reset();
+        words = &inlineWord;
+    }
+    for (uint32_t i = 0; i < wordCount; i++)
+    {
+        uint32_t bits = cabins - i * 64;
+        words[i].store(bits >= 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1, memory_order_relaxed);
+    }
+    hint.store(0, memory_order_relaxed);
+}
+
+uint32_t CabinBitmap::firstNonZero(uint32_t from) const
+{
+    //     :   
+    //      compare-and-swap
+    uint32_t i = from;
+#if defined(__AVX2__)
+    for (; i + 4 <= wordCount; i += 4)
+    {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + i));
+        if (!_mm256_testz_si256(block, block))
+        {
+            break;
+        }
+    }
+#elif defined(PROJECTKR_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 2 <= wordCount; i += 2)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(words + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(block, zero)) != 0xFFFF)
+        {
+            break;
+        }
+    }
+#endif
+    for (; i < wordCount; i++)
+    {
+        if (words[i].load(memory_order_relaxed) != 0)
+        {
+            return i;
+        }
+    }
+    return wordCount;
+}
+
+uint32_t CabinBitmap::takeFirst()
+{
+    uint32_t start = hint.load(memory_order_relaxed);
+    bool wrapped = start == 0;
+    while (true)
+    {
+        uint32_t w = firstNonZero(start);
+        if (w == wordCount)
+        {
+            // ϳ       
+            if (wrapped)
+            {
+                return npos;
+            }
+            start = 0;
+            wrapped = true;
+            continue;
+        }
+        uint64_t current = words[w].load(memory_order_acquire);
+        while (current != 0)
+        {
+            uint64_t bit = current & (~current + 1);
+            if (words[w].compare_exchange_weak(current, current & ~bit, memory_order_acq_rel, memory_order_acquire))
+            {
+                hint.store((current & ~bit) != 0 ? w : w + 1, memory_order_relaxed);
+                return w * 64 + lowestBit(bit);
+            }
+        }
+        start = w; //     -  
+    }
+}
+
+bool CabinBitmap::take(uint32_t index)
+{
+    if (index >= cabins)
+    {
+        return false;
+    }
+    uint64_t bit = uint64_t(1) << (index % 64);
+    return (words[index / 64].fetch_and(~bit, memory_order_acq_rel) & bit) != 0;
+}
+
+void CabinBitmap::release(uint32_t index)
+{
+    if (index >= cabins)
+    {
+        return;
+    }
+    uint32_t w = index / 64;
+    words[w].fetch_or(uint64_t(1) << (index % 64), memory_order_acq_rel);
+    uint32_t current = hint.load(memory_order_relaxed);
+    while (w < current && !hint.compare_exchange_weak(current, w, memory_order_relaxed))
+    {
+    }
+}
+
+bool CabinBitmap::isFree(uint32_t index) const
+{
+    return index < cabins && (words[index / 64].load(memory_order_acquire) >> (index % 64) & 1) != 0;
+}
+
+ShipCabins::ShipCabins(const CabinLayout &layout) : layout(layout)
+{
+    for (int i = 0; i < cabinClassCount; i++)
+    {
+        classes[i].reset(layout.cabins[i]);
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// ʳ   (1 - , 2 - , 3 - )
+const int cabinClassCount = 3;
+
+//      (  16 )
+const uint32_t maxCabinsPerClass = 65535;
+
+// ʳ     .    1 :
+//  ,  ,   .
+struct CabinLayout
+{
+    uint32_t cabins[cabinClassCount];
+
+    uint32_t total() const;
+
+    //    
+    uint32_t firstCabin(int cabinClass) const;
+
+    //       0,     
+    int classOf(uint32_t cabin) const;
+
+    bool isValid() const;
+};
+
+//     : 6 , 2 , 2  
+const CabinLayout defaultCabinLayout = {{6, 2, 2}};
+
+//       (1 - ).
+// ³       (SIMD  
+// )    ,    - 
+// ,     .  :   
+// compare-and-swap,       ,
+//   -    OR.
+class CabinBitmap
+{
+public:
+    static const uint32_t npos = UINT32_MAX;
+
+    CabinBitmap() = default;
+    CabinBitmap(const CabinBitmap &) = delete;
+    CabinBitmap &operator=(const CabinBitmap &) = delete;
+
+    //       (  )
+    void reset(uint32_t cabins);
+
+    uint32_t size() const { return cabins; }
+
+    //    ;    ( 0)  npos
+    uint32_t takeFirst();
+
+    //   ; false,    
+    bool take(uint32_t index);
+
+    void release(uint32_t index);
+    bool isFree(uint32_t index) const;
+
+private:
+    uint32_t cabins = 0;
+    uint32_t wordCount = 0;
+    std::atomic<uint64_t> inlineWord{0};              //    64 
+    std::unique_ptr<std::atomic<uint64_t>[]> storage; //  
+    std::atomic<uint64_t> *words = &inlineWord;
+    std::atomic<uint32_t> hint{0};
+
+    //   ,   from (wordCount,  )
+    uint32_t firstNonZero(uint32_t from) const;
+};
+
+//   :      
+struct ShipCabins
+{
+    CabinLayout layout;
+    CabinBitmap classes[cabinClassCount];
+
+    explicit ShipCabins(const CabinLayout &layout);
+};
@@ -0,0 +1,209 @@
+#include "ConcurrentBooking.h"
+
+#include "InternPool.h"
+#include "Metrics.h"
+#include "Validation.h"
+
+using namespace std;
+
+namespace
+{
+    BookingStatus reservationStatus(SeatReservation reservation)
+    {
+        switch (reservation)
+        {
+        case SeatReservation::ShipFull:
+            return BookingStatus::ShipFull;
+        case SeatReservation::ClassFull:
+            return BookingStatus::CabinClassFull;
+        case SeatReservation::CabinTaken:
+            return BookingStatus::CabinTaken;
+        case SeatReservation::InvalidCabin:
+            return BookingStatus::InvalidCabin;
+        default:
+            return BookingStatus::Ok;
+        }
+    }
+}
+
+ConcurrentBooking::ConcurrentBooking(BookingState &state, Journal *journal) : state(state), journal(journal)
+{
+}
+
+BookingStatus ConcurrentBooking::createPassenger(const string &name, const string &address,
+                                                 const string &phoneNumber, int id)
+{
+    if (!isValidPhoneNumber(phoneNumber))
+    {
+        return BookingStatus::InvalidPhoneNumber;
+    }
+    uint64_t lsn = 0;
+    {
+        lock_guard<mutex> lock(commitLock);
+        //        (createPassenger)
+        BookingStatus status = ::createPassenger(state, name, address, phoneNumber, id, nullptr, journal);
+        if (status != BookingStatus::Ok || journal == nullptr)
+        {
+            return status;
+        }
+        lsn = journal->lastLsn();
+    }
+    return acknowledge(lsn);
+}
+
+BookingStatus ConcurrentBooking::acknowledge(uint64_t lsn)
+{
+    //  commitLock: ,    ,   fsync.
+    //   ,   ,       .
+    return journal->commit(lsn) ? BookingStatus::Ok : BookingStatus::NotDurable;
+}
+
+bool ConcurrentBooking::compactIfNeeded()
+{
+    if (journal == nullptr)
+    {
+        return true;
+    }
+    // ,       commitLock
+    lock_guard<mutex> lock(commitLock);
+    return journal->compactIfNeeded(state.passengers, state.tickets, state.voyages);
+}
+
+BookingStatus ConcurrentBooking::resolveVoyage(const TicketRequest &request, uint32_t &voyageId)
+{
+    //   commitLock:   '    .
+    //     ,     .
+    unique_lock<shared_mutex> lock(routeLock);
+    BookingStatus status = findVoyage(state, request, voyageId);
+    if (status == BookingStatus::Ok && voyageId == VoyageTable::npos)
+    {
+        voyageId = openVoyage(state, request);
+    }
+    return status;
+}
+
+BookingStatus ConcurrentBooking::issueTicket(const TicketRequest &request)
+{
+    METRIC_TIMER(IssueTicket);
+    BookingStatus status = bookTicket(request);
+    if (status != BookingStatus::Ok)
+    {
+        METRIC_COUNT(BookingRejected, 1);
+    }
+    return status;
+}
+
+BookingStatus ConcurrentBooking::bookTicket(const TicketRequest &request)
+{
+    if (request.ticketId < 1)
+    {
+        return BookingStatus::InvalidTicketId;
+    }
+
+    if (request.cabinClass < 1 || request.cabinClass > cabinClassCount)
+    {
+        return BookingStatus::InvalidCabinClass;
+    }
+    if (!isValidPrice(request.cabinClass, request.price))
+    {
+        return BookingStatus::InvalidPrice;
+    }
+
+    //    ;      
+    uint32_t voyageId;
+    CabinLayout layout;
+    {
+        shared_lock<shared_mutex> lock(routeLock);
+        BookingStatus status = findVoyage(state, request, voyageId);
+        if (status != BookingStatus::Ok)
+        {
+            return status;
+        }
+        if (voyageId == VoyageTable::npos)
+        {
+            layout = state.inventory.shipLayout(internPool().find(request.shipName));
+        }
+    }
+    bool newVoyage = voyageId == VoyageTable::npos;
+    //          ,
+    //    ,       
+    if (newVoyage)
+    {
+        if (layout.cabins[request.cabinClass - 1] == 0)
+        {
+            return BookingStatus::CabinClassFull;
+        }
+        if (request.cabin != 0 && layout.classOf(request.cabin) != request.cabinClass)
+        {
+            return BookingStatus::InvalidCabin;
+        }
+    }
+
+    // ̳        
+    uint32_t cabin = 0;
+    if (!newVoyage)
+    {
+        BookingStatus status = reservationStatus(state.inventory.tryReserve(voyageId, request.cabinClass, request.cabin, cabin));
+        if (status != BookingStatus::Ok)
+        {
+            return status;
+        }
+    }
+
+    unique_lock<mutex> lock(commitLock);
+    Passenger *passenger = state.passengers.find(request.passengerId);
+    BookingStatus status = BookingStatus::Ok;
+    if (passenger == nullptr)
+    {
+        status = BookingStatus::PassengerNotFound;
+    }
+    else if (!passenger->tickets.empty())
+    {
+        status = BookingStatus::PassengerHasTicket;
+    }
+    else
+    {
+        status = checkTicketId(state, request.ticketId);
+    }
+    if (status != BookingStatus::Ok)
+    {
+        if (!newVoyage)
+        {
+            state.inventory.release(voyageId, request.cabinClass, cabin);
+        }
+        return status;
+    }
+
+    if (newVoyage)
+    {
+        status = resolveVoyage(request, voyageId);
+        if (status == BookingStatus::Ok)
+        {
+            status = reservationStatus(state.inventory.tryReserve(voyageId, request.cabinClass, request.cabin, cabin));
+        }
+        if (status != BookingStatus::Ok)
+        {
+            return status;
+        }
+    }
+
+    //       commitLock,     .
+    //      ,  '  ':  
+    //  ,      .
+    TicketFields ticket{request.ticketId, state.voyages.voyage(voyageId), request.cabinClass, cabin, request.price};
+    if (journal != nullptr && !journal->appendReservation(*passenger, ticket))
+    {
+        state.inventory.release(voyageId, request.cabinClass, cabin);
+        return BookingStatus::NotPersisted;
+    }
+    state.usedTicketIds.insert(request.ticketId);
+    passenger->tickets.push_back(state.tickets.add(request.ticketId, voyageId, ticket.route, request.cabinClass,
+                                                   cabin, request.price));
+    if (journal == nullptr)
+    {
+        return BookingStatus::Ok;
+    }
+    uint64_t lsn = journal->lastLsn();
+    lock.unlock();
+    return acknowledge(lsn);
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+
+#include "Booking.h"
+#include "Persistence.h"
+
+//         .
+//   ,   createPassenger  issueTicket,   
+//      :
+// - internPool()  VoyageTable -     ,
+//          ;
+// -      -    ShipInventory::tryReserve
+//    ,      ;
+// - ,  ID,     -  
+//   ,       .
+//        (   ,
+//  ID ),    ,   
+// .
+//       ,   NotPersisted  
+// . Ok    Journal::commit ,  
+//        ; commit  
+// commitLock,      fsync (
+// ).  fsync  ,    (NotDurable).
+//   ,      BookingState .
+class ConcurrentBooking
+{
+public:
+    explicit ConcurrentBooking(BookingState &state, Journal *journal = nullptr);
+
+    BookingStatus createPassenger(const std::string &name, const std::string &address,
+                                  const std::string &phoneNumber, int id);
+
+    BookingStatus issueTicket(const TicketRequest &request);
+
+    //  ,   ,  commitLock: 
+    //  ,  ,   commit, - 
+    bool compactIfNeeded();
+
+private:
+    BookingState &state;
+    Journal *journal;
+    std::shared_mutex routeLock;
+    std::mutex commitLock;
+
+    //    ; issueTicket    
+    BookingStatus bookTicket(const TicketRequest &request);
+
+    // ,   lsn    (journal != nullptr)
+    BookingStatus acknowledge(uint64_t lsn);
+
+    //  ;      
+    BookingStatus resolveVoyage(const TicketRequest &request, uint32_t &voyageId);
+};
@@ -0,0 +1,290 @@
+#include "DataLoader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
+#include "InternPool.h"
+#include "MappedFile.h"
+#include "Validation.h"
+
+using namespace std;
+
+namespace
+{
+    //         '
+    class LineReader
+    {
+    public:
+        LineReader(const char *data, size_t size) : current(data), end(data + size) {}
+
+        //    ( '\n'  '\r');   
+        // '\n'     
+        bool next(string_view &line)
+        {
+            if (current >= end)
+            {
+                return false;
+            }
+            const char *newline = static_cast<const char *>(memchr(current, '\n', static_cast<size_t>(end - current)));
+            if (newline == nullptr)
+            {
+                current = end;
+                return false;
+            }
+            const char *lineEnd = newline;
+            if (lineEnd > current && lineEnd[-1] == '\r')
+            {
+                lineEnd--;
+            }
+            line = string_view(current, static_cast<size_t>(lineEnd - current));
+            current = newline + 1;
+            return true;
+        }
+
+    private:
+        const char *current;
+        const char *end;
+    };
+
+    //     prefix,  value   
+    bool takeField(string_view line, string_view prefix, string_view &value)
+    {
+        if (line.size() < prefix.size() || line.compare(0, prefix.size(), prefix) != 0)
+        {
+            return false;
+        }
+        value = line.substr(prefix.size());
+        return true;
+    }
+
+    bool parseInt(string_view text, int &value)
+    {
+        const char *end = text.data() + text.size();
+        from_chars_result result = from_chars(text.data(), end, value);
+        return result.ec == errc() && result.ptr == end;
+    }
+
+    bool parseDouble(string_view text, double &value)
+    {
+        const char *end = text.data() + text.size();
+        from_chars_result result = from_chars(text.data(), end, value);
+        return result.ec == errc() && result.ptr == end;
+    }
+
+    //          '
+    size_t estimateRecords(size_t fileSize, size_t bytesPerRecord)
+    {
+        return fileSize / bytesPerRecord + 1;
+    }
+}
+
+bool loadPassengersFromFile(const string &filename, PassengerRegistry &passengers, IdRegistry &usedIds, LoadStats &stats,
+                            size_t startOffset)
+{
+    MappedFile file;
+    if (!file.open(filename) || startOffset > file.size())
+    {
+        return false;
+    }
+    passengers.reserve(passengers.size() + estimateRecords(file.size() - startOffset, 64));
+
+    LineReader reader(file.data() + startOffset, file.size() - startOffset);
+    string_view line, value;
+    string_view name, address, phoneNumber;
+    bool inRecord = false;
+
+    while (reader.next(line))
+    {
+        if (line == "Passenger")
+        {
+            if (inRecord)
+            {
+                stats.skippedRecords++; //    ID
+            }
+            inRecord = true;
+            name = address = phoneNumber = string_view();
+        }
+        else if (!inRecord)
+        {
+            continue;
+        }
+        else if (takeField(line, "Name: ", value))
+        {
+            name = value;
+        }
+        else if (takeField(line, "Address: ", value))
+        {
+            address = value;
+        }
+        else if (takeField(line, "Phone number: ", value))
+        {
+            phoneNumber = value;
+        }
+        else if (takeField(line, "ID: ", value))
+        {
+            // ID -    
+            inRecord = false;
+            int id;
+            if (!parseInt(value, id) || id < 1 ||
+                passengers.emplace(string(name), string(address), string(phoneNumber), id) == nullptr)
+            {
+                stats.skippedRecords++;
+                continue;
+            }
+            usedIds.insert(id);
+            stats.passengers++;
+        }
+    }
+    if (inRecord)
+    {
+        stats.skippedRecords++;
+    }
+    return true;
+}
+
+bool loadCabinLayouts(const string &filename, ShipInventory &inventory, LoadStats &stats)
+{
+    MappedFile file;
+    if (!file.open(filename))
+    {
+        return false;
+    }
+
+    LineReader reader(file.data(), file.size());
+    string_view line, value, shipName;
+    while (reader.next(line))
+    {
+        if (takeField(line, "Ship Name: ", value))
+        {
+            shipName = value;
+        }
+        else if (takeField(line, "Cabins: ", value))
+        {
+            CabinLayout layout = {};
+            bool ok = !shipName.empty();
+            for (int i = 0; i < cabinClassCount && ok; i++)
+            {
+                size_t space = value.find(' ');
+                int count;
+                ok = parseInt(value.substr(0, space), count) && count >= 0;
+                layout.cabins[i] = static_cast<uint32_t>(max(count, 0));
+                value = space == string_view::npos ? string_view() : value.substr(space + 1);
+            }
+            if (!ok || !value.empty() || !inventory.setLayout(internPool().intern(shipName), layout))
+            {
+                stats.skippedRecords++;
+            }
+            shipName = string_view();
+        }
+    }
+    return true;
+}
+
+bool loadReservationsFromFile(const string &filename, PassengerRegistry &passengers, TicketTable &tickets,
+                              IdRegistry &usedTicketIds, VoyageTable &voyages,
+                              ShipInventory &inventory, LoadStats &stats,
+                              size_t startOffset)
+{
+    MappedFile file;
+    if (!file.open(filename) || startOffset > file.size())
+    {
+        return false;
+    }
+
+    LineReader reader(file.data() + startOffset, file.size() - startOffset);
+    string_view line, value;
+    Passenger *owner = nullptr;
+    bool inTicket = false;
+    int ticketId = 0;
+    int cabinClass = 0;
+    int cabin = 0;
+    string_view shipName, departurePort, destinationPort, date;
+
+    while (reader.next(line))
+    {
+        if (takeField(line, "Reservations for Passenger: ", value))
+        {
+            // '   ,     "(ID: "
+            owner = nullptr;
+            size_t idStart = value.rfind("(ID: ");
+            int passengerId;
+            if (idStart != string_view::npos && value.size() > idStart + 6 && value.back() == ')' &&
+                parseInt(value.substr(idStart + 5, value.size() - idStart - 6), passengerId))
+            {
+                owner = passengers.find(passengerId);
+            }
+            if (owner == nullptr)
+            {
+                stats.skippedRecords++;
+            }
+            inTicket = false;
+        }
+        else if (takeField(line, "Ticket ID: ", value))
+        {
+            inTicket = parseInt(value, ticketId);
+            cabinClass = cabin = 0;
+            shipName = departurePort = destinationPort = date = string_view();
+        }
+        else if (!inTicket)
+        {
+            continue;
+        }
+        else if (takeField(line, "Ship Name: ", value))
+        {
+            shipName = value;
+        }
+        else if (takeField(line, "Departure Port: ", value))
+        {
+            departurePort = value;
+        }
+        else if (takeField(line, "Destination Port: ", value))
+        {
+            destinationPort = value;
+        }
+        else if (takeField(line, "Date: ", value))
+        {
+            date = value;
+        }
+        else if (takeField(line, "Cabin Class: ", value))
+        {
+            parseInt(value, cabinClass);
+        }
+        else if (takeField(line, "Cabin Number: ", value))
+        {
+            parseInt(value, cabin);
+        }
+        else if (takeField(line, "Price: $", value))
+        {
+            // ֳ -   
+            inTicket = false;
+            double price;
+            Date ticketDate;
+            if (owner == nullptr || !parseDouble(value, price) || ticketId < 1 ||
+                !parseStoredDate(date, ticketDate) || !usedTicketIds.insert(ticketId))
+            {
+                stats.skippedRecords++;
+                continue;
+            }
+
+            InternPool &pool = internPool();
+            uint32_t ship = pool.intern(shipName);
+            uint32_t departure = pool.intern(departurePort);
+            uint32_t destination = pool.intern(destinationPort);
+            Voyage route(ship, departure, destination, packDate(ticketDate));
+            //      
+            size_t knownVoyages = voyages.size();
+            uint32_t voyageId = voyages.add(ship, departure, destination, route.date);
+            if (voyages.size() != knownVoyages)
+            {
+                inventory.openVoyage(voyageId, ship);
+            }
+            //     ( )     
+            uint32_t assigned = inventory.recordTicket(voyageId, cabinClass, static_cast<uint32_t>(max(cabin, 0)));
+            owner->tickets.push_back(tickets.add(ticketId, voyageId, route, cabinClass, assigned, price));
+            stats.tickets++;
+        }
+    }
+    return true;
+}
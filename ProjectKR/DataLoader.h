@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "IdRegistry.h"
+#include "Models.h"
+#include "PassengerRegistry.h"
+#include "ShipInventory.h"
+#include "TicketTable.h"
+#include "VoyageTable.h"
+
+// ϳ   
+struct LoadStats
+{
+    size_t passengers = 0;
+    size_t tickets = 0;
+    size_t skippedRecords = 0; // ,    
+};
+
+//  passenger_data.txt       ID.
+//    '     ;
+//    (  ) .
+// startOffset    ,   .
+bool loadPassengersFromFile(const std::string &filename, PassengerRegistry &passengers, IdRegistry &usedIds, LoadStats &stats,
+                            size_t startOffset = 0);
+
+//  ship_layouts.txt (  );  
+//  ,       
+bool loadCabinLayouts(const std::string &filename, ShipInventory &inventory, LoadStats &stats);
+
+//  reservations.txt:        
+//  ,  usedTicketIds,  (  
+// )   
+bool loadReservationsFromFile(const std::string &filename, PassengerRegistry &passengers, TicketTable &tickets,
+                              IdRegistry &usedTicketIds, VoyageTable &voyages,
+                              ShipInventory &inventory, LoadStats &stats,
+                              size_t startOffset = 0);
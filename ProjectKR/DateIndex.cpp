@@ -0,0 +1,51 @@
+#include "DateIndex.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace
+{
+    bool entryLess(const DateIndex::Entry &a, const DateIndex::Entry &b)
+    {
+        return a.date < b.date || (a.date == b.date && a.key < b.key);
+    }
+}
+
+void DateIndex::merge() const
+{
+    if (sortedCount == entries.size())
+    {
+        return;
+    }
+    auto middle = entries.begin() + static_cast<ptrdiff_t>(sortedCount);
+    sort(middle, entries.end(), entryLess);
+    //       ,   
+    if (sortedCount > 0 && entryLess(*middle, *(middle - 1)))
+    {
+        inplace_merge(entries.begin(), middle, entries.end(), entryLess);
+    }
+    sortedCount = entries.size();
+}
+
+const DateIndex::Entry *DateIndex::lowerBound(uint32_t from) const
+{
+    merge();
+    auto bound = partition_point(entries.begin(), entries.end(), [from](const Entry &entry)
+                                 { return entry.date < from; });
+    return entries.data() + (bound - entries.begin());
+}
+
+const DateIndex::Entry *DateIndex::upperBound(uint32_t to) const
+{
+    merge();
+    auto bound = partition_point(entries.begin(), entries.end(), [to](const Entry &entry)
+                                 { return entry.date <= to; });
+    return entries.data() + (bound - entries.begin());
+}
+
+void DateIndex::clear()
+{
+    entries.clear();
+    sortedCount = 0;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ³     ( , ).   
+//   ,       , 
+//  - O(1),    -     .
+// ˳    ,     
+//    .
+class DateIndex
+{
+public:
+    struct Entry
+    {
+        uint32_t date;
+        uint32_t key;
+    };
+
+    void add(uint32_t date, uint32_t key) { entries.push_back(Entry{date, key}); }
+
+    //      [from, to],   
+    const Entry *lowerBound(uint32_t from) const;
+    const Entry *upperBound(uint32_t to) const;
+
+    size_t size() const { return entries.size(); }
+    void reserve(size_t count) { entries.reserve(count); }
+    void clear();
+
+private:
+    mutable std::vector<Entry> entries;
+    mutable size_t sortedCount = 0;
+
+    void merge() const;
+};
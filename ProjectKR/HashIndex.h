@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// -    ( ),  
+//        .
+//  0     .
+class HashIndex
+{
+public:
+    static const uint32_t npos = 0xFFFFFFFFu;
+
+    HashIndex() : count(0)
+    {
+        rehash(16);
+    }
+
+    //     , npos   
+    uint32_t find(uint64_t key) const
+    {
+        size_t mask = keys.size() - 1;
+        for (size_t i = hash(key) & mask;; i = (i + 1) & mask)
+        {
+            if (keys[i] == key)
+            {
+                return values[i];
+            }
+            if (keys[i] == 0)
+            {
+                return npos;
+            }
+        }
+    }
+
+    bool contains(uint64_t key) const
+    {
+        return find(key) != npos;
+    }
+
+    //  ;  false,       
+    bool insert(uint64_t key, uint32_t value)
+    {
+        //     70%,     
+        if ((count + 1) * 10 > keys.size() * 7)
+        {
+            rehash(keys.size() * 2);
+        }
+        size_t mask = keys.size() - 1;
+        size_t i = hash(key) & mask;
+        while (keys[i] != 0)
+        {
+            if (keys[i] == key)
+            {
+                return false;
+            }
+            i = (i + 1) & mask;
+        }
+        keys[i] = key;
+        values[i] = value;
+        count++;
+        return true;
+    }
+
+    //     n   
+    void reserve(size_t n)
+    {
+        size_t capacity = keys.size();
+        while (n * 10 > capacity * 7)
+        {
+            capacity *= 2;
+        }
+        if (capacity != keys.size())
+        {
+            rehash(capacity);
+        }
+    }
+
+    void clear()
+    {
+        keys.assign(keys.size(), 0);
+        count = 0;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+private:
+    std::vector<uint64_t> keys;
+    std::vector<uint32_t> values;
+    size_t count;
+
+    //    ( MurmurHash3),   ID
+    //    
+    static uint64_t hash(uint64_t key)
+    {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        key *= 0xc4ceb9fe1a85ec53ULL;
+        key ^= key >> 33;
+        return key;
+    }
+
+    void rehash(size_t capacity)
+    {
+        std::vector<uint64_t> oldKeys(capacity, 0);
+        std::vector<uint32_t> oldValues(capacity, 0);
+        oldKeys.swap(keys);
+        oldValues.swap(values);
+
+        size_t mask = capacity - 1;
+        for (size_t j = 0; j < oldKeys.size(); j++)
+        {
+            if (oldKeys[j] == 0)
+            {
+                continue;
+            }
+            size_t i = hash(oldKeys[j]) & mask;
+            while (keys[i] != 0)
+            {
+                i = (i + 1) & mask;
+            }
+            keys[i] = oldKeys[j];
+            values[i] = oldValues[j];
+        }
+    }
+};
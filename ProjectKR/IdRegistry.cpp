@@ -0,0 +1,343 @@
+#include "IdRegistry.h"
+
+#include <algorithm>
+#include <bitset>
+#include <climits>
+#include <cstring>
+
+using namespace std;
+
+namespace
+{
+    const char idRegistryMagic[8] = {'K', 'R', 'I', 'D', 'S', 'E', 'T', '1'};
+
+    struct SerializedHeader
+    {
+        char magic[8];
+        uint32_t containers;
+        uint32_t reserved;
+        uint64_t ids;
+    };
+
+    struct SerializedContainer
+    {
+        uint32_t key;
+        uint32_t cardinality; //   4096 - ,   
+    };
+
+    size_t bitCount(uint64_t word)
+    {
+        return bitset<64>(word).count();
+    }
+
+    //     (word != 0)
+    uint32_t lowestBit(uint64_t word)
+    {
+        return static_cast<uint32_t>(bitCount((word & (~word + 1)) - 1));
+    }
+
+    //     (word != 0)
+    uint32_t highestBit(uint64_t word)
+    {
+        uint32_t bit = 63;
+        while ((word >> bit & 1) == 0)
+        {
+            bit--;
+        }
+        return bit;
+    }
+
+    template <typename T>
+    bool readValue(string_view &data, T &value)
+    {
+        if (data.size() < sizeof(T))
+        {
+            return false;
+        }
+        memcpy(&value, data.data(), sizeof(T));
+        data.remove_prefix(sizeof(T));
+        return true;
+    }
+}
+
+const IdRegistry::Container *IdRegistry::findContainer(uint32_t key) const
+{
+    if (key >= directory.size() || directory[key] == none)
+    {
+        return nullptr;
+    }
+    return &containers[directory[key]];
+}
+
+IdRegistry::Container &IdRegistry::obtainContainer(uint32_t key)
+{
+    if (key >= directory.size())
+    {
+        directory.resize(key + 1, none);
+    }
+    if (directory[key] == none)
+    {
+        directory[key] = static_cast<uint32_t>(containers.size());
+        containers.emplace_back();
+        containers.back().key = key;
+        containers.back().cardinality = 0;
+    }
+    return containers[directory[key]];
+}
+
+void IdRegistry::toBitmap(Container &container)
+{
+    container.bits.assign(bitmapWords, 0);
+    for (uint16_t low : container.values)
+    {
+        container.bits[low >> 6] |= uint64_t(1) << (low & 63);
+    }
+    vector<uint16_t>().swap(container.values);
+}
+
+bool IdRegistry::contains(int id) const
+{
+    if (id < 0)
+    {
+        return false;
+    }
+    const Container *container = findContainer(static_cast<uint32_t>(id) >> 16);
+    if (container == nullptr)
+    {
+        return false;
+    }
+    uint16_t low = static_cast<uint16_t>(id & 0xFFFF);
+    if (!container->bits.empty())
+    {
+        return (container->bits[low >> 6] >> (low & 63)) & 1;
+    }
+    return binary_search(container->values.begin(), container->values.end(), low);
+}
+
+bool IdRegistry::insert(int id)
+{
+    if (id < 0)
+    {
+        return false;
+    }
+    Container &container = obtainContainer(static_cast<uint32_t>(id) >> 16);
+    uint16_t low = static_cast<uint16_t>(id & 0xFFFF);
+    if (container.bits.empty())
+    {
+        auto position = lower_bound(container.values.begin(), container.values.end(), low);
+        if (position != container.values.end() && *position == low)
+        {
+            return false;
+        }
+        if (container.cardinality < arrayLimit)
+        {
+            container.values.insert(position, low);
+        }
+        else
+        {
+            toBitmap(container);
+        }
+    }
+    if (!container.bits.empty())
+    {
+        uint64_t &word = container.bits[low >> 6];
+        uint64_t bit = uint64_t(1) << (low & 63);
+        if (word & bit)
+        {
+            return false;
+        }
+        word |= bit;
+    }
+    container.cardinality++;
+    count++;
+    largest = max(largest, id);
+    return true;
+}
+
+void IdRegistry::clear()
+{
+    directory.clear();
+    containers.clear();
+    count = 0;
+    largest = 0;
+}
+
+int IdRegistry::nextFree(int from) const
+{
+    //    ,    from
+    for (int64_t id = max(from, 1); id <= INT_MAX;)
+    {
+        uint32_t key = static_cast<uint32_t>(id) >> 16;
+        uint32_t low = static_cast<uint32_t>(id) & 0xFFFF;
+        const Container *container = findContainer(key);
+        if (container == nullptr)
+        {
+            return static_cast<int>(id);
+        }
+        //      
+        if (!container->bits.empty() && container->cardinality < 0x10000)
+        {
+            for (uint32_t word = low >> 6; word < bitmapWords; word++)
+            {
+                uint64_t free = ~container->bits[word];
+                if (word == low >> 6)
+                {
+                    free &= ~uint64_t(0) << (low & 63);
+                }
+                if (free != 0)
+                {
+                    return static_cast<int>(key << 16 | (word << 6 | lowestBit(free)));
+                }
+            }
+        }
+        else if (container->bits.empty())
+        {
+            auto position = lower_bound(container->values.begin(), container->values.end(), static_cast<uint16_t>(low));
+            while (position != container->values.end() && *position == low)
+            {
+                position++;
+                low++;
+            }
+            if (low <= 0xFFFF)
+            {
+                return static_cast<int>(key << 16 | low);
+            }
+        }
+        id = (static_cast<int64_t>(key) + 1) << 16;
+    }
+    return 0;
+}
+
+int IdRegistry::nextId(IdAllocation policy) const
+{
+    if (policy == IdAllocation::Monotonic && largest < INT_MAX)
+    {
+        return largest + 1;
+    }
+    return nextFree();
+}
+
+size_t IdRegistry::memoryUsage() const
+{
+    size_t bytes = directory.capacity() * sizeof(uint32_t) + containers.capacity() * sizeof(Container);
+    for (const Container &container : containers)
+    {
+        bytes += container.values.capacity() * sizeof(uint16_t) + container.bits.capacity() * sizeof(uint64_t);
+    }
+    return bytes;
+}
+
+void IdRegistry::serialize(string &out) const
+{
+    SerializedHeader header;
+    memcpy(header.magic, idRegistryMagic, sizeof(header.magic));
+    header.containers = static_cast<uint32_t>(containers.size());
+    header.reserved = 0;
+    header.ids = count;
+
+    size_t size = sizeof(header);
+    for (const Container &container : containers)
+    {
+        size += sizeof(SerializedContainer) + container.values.size() * sizeof(uint16_t) + container.bits.size() * sizeof(uint64_t);
+    }
+    out.clear();
+    out.reserve(size);
+    out.append(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    //    ,      
+    for (uint32_t index : directory)
+    {
+        if (index == none)
+        {
+            continue;
+        }
+        const Container &container = containers[index];
+        SerializedContainer record{container.key, container.cardinality};
+        out.append(reinterpret_cast<const char *>(&record), sizeof(record));
+        if (container.bits.empty())
+        {
+            out.append(reinterpret_cast<const char *>(container.values.data()), container.values.size() * sizeof(uint16_t));
+        }
+        else
+        {
+            out.append(reinterpret_cast<const char *>(container.bits.data()), container.bits.size() * sizeof(uint64_t));
+        }
+    }
+}
+
+bool IdRegistry::deserialize(string_view data)
+{
+    clear();
+    SerializedHeader header;
+    if (!readValue(data, header) || memcmp(header.magic, idRegistryMagic, sizeof(header.magic)) != 0)
+    {
+        return false;
+    }
+
+    bool ok = true;
+    uint32_t previousKey = 0;
+    for (uint32_t i = 0; i < header.containers && ok; i++)
+    {
+        SerializedContainer record;
+        //  , ID   INT_MAX,   
+        ok = readValue(data, record) && (i == 0 || record.key > previousKey) && record.key <= (INT_MAX >> 16) &&
+             record.cardinality >= 1 && record.cardinality <= 0x10000;
+        if (!ok)
+        {
+            break;
+        }
+        previousKey = record.key;
+        Container &container = obtainContainer(record.key);
+        container.cardinality = record.cardinality;
+        uint32_t last = 0;
+        if (record.cardinality <= arrayLimit)
+        {
+            size_t bytes = record.cardinality * sizeof(uint16_t);
+            ok = data.size() >= bytes;
+            if (ok)
+            {
+                container.values.resize(record.cardinality);
+                memcpy(container.values.data(), data.data(), bytes);
+                data.remove_prefix(bytes);
+                ok = adjacent_find(container.values.begin(), container.values.end(), greater_equal<uint16_t>()) ==
+                     container.values.end();
+                last = container.values.back();
+            }
+        }
+        else
+        {
+            size_t bytes = bitmapWords * sizeof(uint64_t);
+            ok = data.size() >= bytes;
+            if (ok)
+            {
+                container.bits.resize(bitmapWords);
+                memcpy(container.bits.data(), data.data(), bytes);
+                data.remove_prefix(bytes);
+                size_t bits = 0;
+                uint32_t lastWord = 0;
+                for (uint32_t word = 0; word < bitmapWords; word++)
+                {
+                    bits += bitCount(container.bits[word]);
+                    lastWord = container.bits[word] != 0 ? word : lastWord;
+                }
+                //     ,  highestBit(0)  
+                ok = bits == record.cardinality;
+                if (ok && bits != 0)
+                {
+                    last = lastWord << 6 | highestBit(container.bits[lastWord]);
+                }
+            }
+        }
+        if (ok)
+        {
+            count += record.cardinality;
+            largest = static_cast<int>(record.key << 16 | last);
+        }
+    }
+    if (!ok || count != header.ids || !data.empty())
+    {
+        clear();
+        return false;
+    }
+    return true;
+}
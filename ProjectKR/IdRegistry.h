@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//   ID   ,     
+enum class IdAllocation
+{
+    Monotonic, //    : ID   
+    LowestFree //  :  
+};
+
+//   ID (  ) -   
+//   Roaring. ID    16  ( ) 
+//  16  (  ).   - 
+//    ( 4096 , 2   ID),  - 
+//   65536  (8 , 1   ID).    
+//  ,   ID -      
+//       4096 ,     
+//  ID,   std::set<int>.
+class IdRegistry
+{
+public:
+    IdRegistry() : count(0), largest(0) {}
+
+    // ID >= 0; ' ID   
+    bool contains(int id) const;
+
+    //  ID;  false,  ID '   
+    bool insert(int id);
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    void clear();
+
+    //   ID (0,   )
+    int maxId() const { return largest; }
+
+    //   ID,    from (from >= 1);
+    // 0,   ID  
+    int nextFree(int from = 1) const;
+
+    // ID      policy (0,   ID ).
+    // ID  :     insert.
+    int nextId(IdAllocation policy) const;
+
+    // ',   ,  
+    size_t memoryUsage() const;
+
+    //   (  x86/x64): ,  
+    //   ,  ID   - ,  ID 
+    //  4096,   .    .
+    void serialize(std::string &out) const;
+
+    // ³  serialize;      
+    //   false
+    bool deserialize(std::string_view data);
+
+private:
+    static constexpr uint32_t arrayLimit = 4096;  //       
+    static constexpr uint32_t bitmapWords = 1024; // 65536 
+    static constexpr uint32_t none = 0xFFFFFFFFu;
+
+    struct Container
+    {
+        uint32_t key; //  16  ID
+        uint32_t cardinality;
+        std::vector<uint16_t> values; //  
+        std::vector<uint64_t> bits;   // ٳ  (    )
+    };
+
+    std::vector<uint32_t> directory; //  16  ->   containers  none
+    std::vector<Container> containers;
+    size_t count;
+    int largest;
+
+    const Container *findContainer(uint32_t key) const;
+    Container &obtainContainer(uint32_t key);
+    static void toBitmap(Container &container);
+};
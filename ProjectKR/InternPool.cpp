@@ -0,0 +1,28 @@
+#include "InternPool.h"
+
+using namespace std;
+
+uint32_t InternPool::intern(string_view text)
+{
+    auto existing = ids.find(text);
+    if (existing != ids.end())
+    {
+        return existing->second;
+    }
+    uint32_t id = static_cast<uint32_t>(strings.size());
+    strings.emplace_back(text);
+    ids.emplace(string_view(strings.back()), id);
+    return id;
+}
+
+uint32_t InternPool::find(string_view text) const
+{
+    auto existing = ids.find(text);
+    return existing != ids.end() ? existing->second : npos;
+}
+
+InternPool &internPool()
+{
+    static InternPool pool;
+    return pool;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+//    (   ).   
+//      ;     
+// .    ,    string_view, 
+// ,    .
+class InternPool
+{
+public:
+    static const uint32_t npos = UINT32_MAX;
+
+    //  ;      
+    uint32_t intern(std::string_view text);
+
+    //    npos,      
+    uint32_t find(std::string_view text) const;
+
+    std::string_view view(uint32_t id) const { return strings[id]; }
+    size_t size() const { return strings.size(); }
+
+private:
+    // deque     ,  -string_view  
+    std::deque<std::string> strings;
+    std::unordered_map<std::string_view, uint32_t> ids;
+};
+
+//     񳺿 
+InternPool &internPool();
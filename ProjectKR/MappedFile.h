@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// ,   '    (mmap / MapViewOfFile).
+//        .
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // ³   ;     size() == 0
+    bool open(const std::string &filename);
+    void close();
+
+    bool isOpen() const { return opened; }
+    const char *data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    const char *bytes;
+    size_t length;
+    bool opened;
+#ifdef _WIN32
+    void *fileHandle;
+    void *mappingHandle;
+#endif
+};
@@ -0,0 +1,297 @@
+#include "Metrics.h"
+
+#include <charconv>
+#include <csignal>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+    //       ;    
+    volatile sig_atomic_t dumpRequested = 0;
+
+    extern "C" void requestMetricsDump(int)
+    {
+        dumpRequested = 1;
+    }
+}
+
+#ifdef PROJECTKR_METRICS
+
+namespace
+{
+    struct MetricInfo
+    {
+        const char *name;
+        const char *help;
+    };
+
+    //    LatencyMetric
+    const MetricInfo latencyInfo[latencyMetricCount] = {
+        {"booking_create_passenger", "createPassenger"},
+        {"booking_issue_ticket", "issueTicket (single and concurrent booking)"},
+        {"validation_phone", "Phone number validation"},
+        {"validation_date", "Date validation"},
+        {"validation_phone_batch", "Batch phone number validation"},
+        {"validation_date_batch", "Batch date validation"},
+        {"query_count_passengers_on_ship", "countPassengersOnShip"},
+        {"query_unique_ship_names", "getUniqueShipNames"},
+        {"query_popular_cabin_classes", "getMostPopularCabinClasses"},
+        {"query_total_revenue", "calculateTotalRevenue"},
+        {"query_count_passengers", "countPassengers"},
+        {"query_popular_destinations", "getMostPopularDestinationPorts"},
+        {"query_departures_between", "getDeparturesBetween"},
+        {"query_revenue_between", "calculateRevenueBetween"},
+        {"query_ship_report", "getShipReport"},
+        {"query_voyage_report", "getVoyageReport"},
+        {"query_top_destinations", "getTopDestinations over all tickets"},
+        {"query_top_destinations_between", "getTopDestinations for a date range"},
+        {"query_route_search", "findSailings for one route query"},
+        {"write_passenger_file", "Full rewrite of passenger_data.txt"},
+        {"write_reservation_file", "Full rewrite of reservations.txt"},
+        {"write_cabin_layout_file", "Rewrite of ship_layouts.txt"},
+        {"write_snapshot", "Binary snapshot write"},
+        {"journal_append", "Journal record append including fsync policy"},
+        {"fsync", "File sync to disk"},
+    };
+
+    const MetricInfo counterInfo[counterMetricCount] = {
+        {"booking_rejected_total", "Booking requests rejected by checks"},
+        {"invalid_input_total", "Phone numbers and dates that failed validation"},
+        {"bytes_written_total", "Bytes written to data files"},
+        {"backpressure_waits_total", "Record submissions that waited for the background journal queue"},
+    };
+
+    mutex registryLock;
+    vector<unique_ptr<ThreadMetrics>> registry;
+    thread_local ThreadMetrics *localMetrics = nullptr;
+
+    //   ()  
+    uint64_t bucketLimit(size_t bucket)
+    {
+        if (bucket < 16)
+        {
+            return bucket + 1;
+        }
+        size_t exponent = 4 + (bucket - 16) / 8;
+        uint64_t step = 1ull << (exponent - 3);
+        return (8 + (bucket - 16) % 8) * step + step;
+    }
+
+    void appendSeconds(string &out, uint64_t nanoseconds)
+    {
+        char buffer[32];
+        to_chars_result result = to_chars(buffer, buffer + sizeof(buffer), static_cast<double>(nanoseconds) / 1e9);
+        out.append(buffer, result.ptr);
+    }
+
+    void appendNumber(string &out, uint64_t value)
+    {
+        char buffer[24];
+        to_chars_result result = to_chars(buffer, buffer + sizeof(buffer), value);
+        out.append(buffer, result.ptr);
+    }
+
+    void appendHeader(string &out, const string &name, const char *help, const char *type)
+    {
+        out += "# HELP ";
+        out += name;
+        out += ' ';
+        out += help;
+        out += "\n# TYPE ";
+        out += name;
+        out += ' ';
+        out += type;
+        out += '\n';
+    }
+}
+
+ThreadMetrics &threadMetrics()
+{
+    if (localMetrics == nullptr)
+    {
+        //      :  
+        //   
+        lock_guard<mutex> guard(registryLock);
+        registry.push_back(unique_ptr<ThreadMetrics>(new ThreadMetrics()));
+        localMetrics = registry.back().get();
+    }
+    return *localMetrics;
+}
+
+bool metricsEnabled()
+{
+    return true;
+}
+
+void writePrometheusMetrics(string &out)
+{
+    // ϳ   
+    vector<uint64_t> calls(latencyMetricCount), sums(latencyMetricCount), counters(counterMetricCount);
+    vector<uint64_t> buckets(latencyMetricCount * histogramBuckets);
+    {
+        lock_guard<mutex> guard(registryLock);
+        for (const unique_ptr<ThreadMetrics> &block : registry)
+        {
+            for (size_t metric = 0; metric < latencyMetricCount; metric++)
+            {
+                calls[metric] += block->calls[metric].load(memory_order_relaxed);
+                sums[metric] += block->sampledNanoseconds[metric].load(memory_order_relaxed);
+                for (size_t bucket = 0; bucket < histogramBuckets; bucket++)
+                {
+                    buckets[metric * histogramBuckets + bucket] += block->buckets[metric][bucket].load(memory_order_relaxed);
+                }
+            }
+            for (size_t counter = 0; counter < counterMetricCount; counter++)
+            {
+                counters[counter] += block->counters[counter].load(memory_order_relaxed);
+            }
+        }
+    }
+
+    for (size_t metric = 0; metric < latencyMetricCount; metric++)
+    {
+        string name = string("projectkr_") + latencyInfo[metric].name;
+        appendHeader(out, name + "_calls_total", latencyInfo[metric].help, "counter");
+        out += name;
+        out += "_calls_total ";
+        appendNumber(out, calls[metric]);
+        out += '\n';
+
+        //      ,      
+        // .       ,  
+        //    +Inf.
+        string histogram = name + "_seconds";
+        appendHeader(out, histogram, latencyInfo[metric].help, "histogram");
+        uint64_t cumulative = 0;
+        for (size_t bucket = 0; bucket + 1 < histogramBuckets; bucket++)
+        {
+            cumulative += buckets[metric * histogramBuckets + bucket];
+            out += histogram;
+            out += "_bucket{le=\"";
+            appendSeconds(out, bucketLimit(bucket));
+            out += "\"} ";
+            appendNumber(out, cumulative);
+            out += '\n';
+        }
+        cumulative += buckets[metric * histogramBuckets + histogramBuckets - 1];
+        out += histogram;
+        out += "_bucket{le=\"+Inf\"} ";
+        appendNumber(out, cumulative);
+        out += '\n';
+        out += histogram;
+        out += "_sum ";
+        appendSeconds(out, sums[metric]);
+        out += '\n';
+        out += histogram;
+        out += "_count ";
+        appendNumber(out, cumulative);
+        out += '\n';
+    }
+
+    for (size_t counter = 0; counter < counterMetricCount; counter++)
+    {
+        string name = string("projectkr_") + counterInfo[counter].name;
+        appendHeader(out, name, counterInfo[counter].help, "counter");
+        out += name;
+        out += ' ';
+        appendNumber(out, counters[counter]);
+        out += '\n';
+    }
+}
+
+#else
+
+bool metricsEnabled()
+{
+    return false;
+}
+
+void writePrometheusMetrics(string &out)
+{
+    out += "# ProjectKR was built without PROJECTKR_METRICS; no metrics are collected.\n";
+}
+
+#endif
+
+MetricsExporter::~MetricsExporter()
+{
+    stop();
+}
+
+bool MetricsExporter::start(const string &file, int intervalSeconds)
+{
+    if (!metricsEnabled() || worker.joinable())
+    {
+        return false;
+    }
+    filename = file;
+    interval = chrono::seconds(intervalSeconds > 0 ? intervalSeconds : 1);
+    stopping = false;
+#ifdef SIGUSR1
+    signal(SIGUSR1, requestMetricsDump);
+#endif
+    worker = thread(&MetricsExporter::run, this);
+    return true;
+}
+
+void MetricsExporter::stop()
+{
+    if (!worker.joinable())
+    {
+        return;
+    }
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+    writeNow(); // ϳ   
+}
+
+bool MetricsExporter::writeNow() const
+{
+    string text;
+    writePrometheusMetrics(text);
+    string temp = filename + ".tmp";
+    FILE *file = fopen(temp.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    bool ok = fwrite(text.data(), 1, text.size(), file) == text.size();
+    ok = fclose(file) == 0 && ok;
+    error_code error;
+    filesystem::rename(temp, filename, error);
+    return ok && !error;
+}
+
+void MetricsExporter::run()
+{
+    //    100 ,     interval
+    const chrono::milliseconds poll(100);
+    chrono::steady_clock::time_point next = chrono::steady_clock::now() + interval;
+    unique_lock<mutex> guard(lock);
+    while (!stopping)
+    {
+        wake.wait_for(guard, poll);
+        if (stopping)
+        {
+            break;
+        }
+        chrono::steady_clock::time_point now = chrono::steady_clock::now();
+        if (dumpRequested != 0 || now >= next)
+        {
+            dumpRequested = 0;
+            next = now + interval;
+            guard.unlock();
+            writeNow();
+            guard.lock();
+        }
+    }
+}
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+//   :     
+// (  HDR Histogram: 8     ,   12.5%)
+//  ,  ,     .
+//           
+//  --;     .
+//   PROJECTKR_METRICS    : 
+// METRIC_TIMER  METRIC_COUNT  ,   , 
+//  .
+
+//  Prometheus (text exposition format)   
+void writePrometheusMetrics(std::string &out);
+
+bool metricsEnabled();
+
+//      (    ).
+//      SIGUSR1 (  )   .
+class MetricsExporter
+{
+public:
+    MetricsExporter() = default;
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter &) = delete;
+    MetricsExporter &operator=(const MetricsExporter &) = delete;
+
+    // false,     
+    bool start(const std::string &filename, int intervalSeconds);
+    void stop();
+
+    bool writeNow() const;
+
+private:
+    std::string filename;
+    std::chrono::seconds interval{10};
+    std::thread worker;
+    std::mutex lock;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    void run();
+};
+
+#ifdef PROJECTKR_METRICS
+
+//  ;    -  Metrics.cpp
+enum class LatencyMetric
+{
+    CreatePassenger,
+    IssueTicket,
+    ValidatePhone,
+    ValidateDate,
+    ValidatePhoneBatch,
+    ValidateDateBatch,
+    CountPassengersOnShip,
+    UniqueShipNames,
+    PopularCabinClasses,
+    TotalRevenue,
+    CountPassengers,
+    PopularDestinations,
+    DeparturesBetween,
+    RevenueBetween,
+    ShipReport,
+    VoyageReport,
+    TopDestinations,
+    TopDestinationsBetween,
+    RouteSearch,
+    WritePassengerFile,
+    WriteReservationFile,
+    WriteCabinLayoutFile,
+    WriteSnapshot,
+    JournalAppend,
+    Fsync,
+    Count
+};
+
+enum class CounterMetric
+{
+    BookingRejected,
+    InvalidInput,
+    BytesWritten,
+    BackpressureWaits,
+    Count
+};
+
+const size_t latencyMetricCount = static_cast<size_t>(LatencyMetric::Count);
+const size_t counterMetricCount = static_cast<size_t>(CounterMetric::Count);
+
+//  :   16  - ,   8   
+//   2^40  ( 18 )
+const size_t histogramBuckets = 16 + 37 * 8;
+
+inline size_t histogramBucket(uint64_t nanoseconds)
+{
+    if (nanoseconds < 16)
+    {
+        return static_cast<size_t>(nanoseconds);
+    }
+#ifdef _MSC_VER
+    unsigned long highest;
+    _BitScanReverse64(&highest, nanoseconds);
+    unsigned exponent = static_cast<unsigned>(highest);
+#else
+    unsigned exponent = 63 - static_cast<unsigned>(__builtin_clzll(nanoseconds));
+#endif
+    size_t bucket = 16 + (exponent - 4) * 8 + ((nanoseconds >> (exponent - 3)) & 7);
+    return bucket < histogramBuckets ? bucket : histogramBuckets - 1;
+}
+
+//   (  -  )  
+//   2^k-  ,      
+// ;    
+constexpr uint64_t metricSampleMask(LatencyMetric metric)
+{
+    return metric == LatencyMetric::ValidatePhone || metric == LatencyMetric::ValidateDate ? 63
+           : metric == LatencyMetric::RouteSearch                                         ? 15
+                                                                                          : 0;
+}
+
+//    .   - (relaxed load 
+// store   ),   .
+struct ThreadMetrics
+{
+    std::atomic<uint64_t> calls[latencyMetricCount];
+    std::atomic<uint64_t> sampledNanoseconds[latencyMetricCount];
+    std::atomic<uint64_t> buckets[latencyMetricCount][histogramBuckets];
+    std::atomic<uint64_t> counters[counterMetricCount];
+};
+
+//   ;         
+ThreadMetrics &threadMetrics();
+
+inline void bumpMetric(std::atomic<uint64_t> &value, uint64_t amount)
+{
+    value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+inline void addMetric(CounterMetric counter, uint64_t amount)
+{
+    bumpMetric(threadMetrics().counters[static_cast<size_t>(counter)], amount);
+}
+
+//        
+class MetricTimer
+{
+public:
+    explicit MetricTimer(LatencyMetric metric) : metric(static_cast<size_t>(metric)), block(threadMetrics())
+    {
+        uint64_t calls = block.calls[this->metric].load(std::memory_order_relaxed);
+        block.calls[this->metric].store(calls + 1, std::memory_order_relaxed);
+        sampled = (calls & metricSampleMask(metric)) == 0;
+        if (sampled)
+        {
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~MetricTimer()
+    {
+        if (sampled)
+        {
+            uint64_t nanoseconds = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+            bumpMetric(block.sampledNanoseconds[metric], nanoseconds);
+            bumpMetric(block.buckets[metric][histogramBucket(nanoseconds)], 1);
+        }
+    }
+
+    MetricTimer(const MetricTimer &) = delete;
+    MetricTimer &operator=(const MetricTimer &) = delete;
+
+private:
+    size_t metric;
+    ThreadMetrics &block;
+    bool sampled;
+    std::chrono::steady_clock::time_point start;
+};
+
+#define METRIC_TIMER(metric) MetricTimer metricTimer(LatencyMetric::metric)
+#define METRIC_COUNT(counter, amount) addMetric(CounterMetric::counter, static_cast<uint64_t>(amount))
+
+#else
+
+#define METRIC_TIMER(metric) ((void)0)
+#define METRIC_COUNT(counter, amount) ((void)0)
+
+#endif
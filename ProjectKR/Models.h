@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ,    ( )
+class Person
+{
+public:
+    std::string name;
+    std::string phoneNumber;
+
+    //  Person;      ,
+    //      
+    Person(std::string n, std::string phone) : name(std::move(n)), phoneNumber(std::move(phone)) {}
+
+    //        
+    virtual void displayInfo() const = 0;
+};
+
+//      TicketTable.    
+//   ,       ' 
+//       (   ).
+class TicketList
+{
+public:
+    TicketList() : first(0), count(0) {}
+
+    void push_back(uint32_t row)
+    {
+        if (count == 0)
+        {
+            first = row;
+        }
+        else
+        {
+            if (count == 1)
+            {
+                more.push_back(first);
+            }
+            more.push_back(row);
+        }
+        count++;
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    uint32_t back() const { return begin()[count - 1]; }
+
+    const uint32_t *begin() const { return count > 1 ? more.data() : &first; }
+    const uint32_t *end() const { return begin() + count; }
+
+private:
+    uint32_t first;
+    uint32_t count;
+    std::vector<uint32_t> more; //  ,    
+};
+
+//    ,   
+class Passenger : public Person
+{
+public:
+    int id;
+    std::string address;
+    TicketList tickets;
+
+    Passenger(std::string n, std::string addr, std::string phone, int i)
+        : Person(std::move(n), std::move(phone)), id(i), address(std::move(addr)) {}
+
+    //      
+    void displayInfo() const override
+    {
+        std::cout << std::endl;
+        std::cout << "Passenger information:" << std::endl;
+        std::cout << "Name: " << name << std::endl;
+        std::cout << "Address: " << address << std::endl;
+        std::cout << "Phone number: " << phoneNumber << std::endl;
+        std::cout << "ID: " << id << std::endl;
+        std::cout << std::endl;
+    }
+};
+
+//  :    -   internPool(),   - packDate
+class Voyage
+{
+public:
+    uint32_t shipId;
+    uint32_t departurePort;
+    uint32_t destinationPort;
+    uint32_t date;
+
+    Voyage() : shipId(0), departurePort(0), destinationPort(0), date(0) {}
+
+    Voyage(uint32_t ship, uint32_t depart, uint32_t dest, uint32_t d) : shipId(ship), departurePort(depart), destinationPort(dest), date(d) {}
+};
+
+// ,   
+class Ship
+{
+public:
+    // ̳       (defaultCabinLayout);
+    //       ,   
+    static inline int maxPassengerCapacity = 10;
+
+    static void setMaxPassengerCapacity(int capacity)
+    {
+        maxPassengerCapacity = capacity;
+    }
+};
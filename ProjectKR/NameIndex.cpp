@@ -0,0 +1,138 @@
+#include "NameIndex.h"
+
+#include <algorithm>
+
+using namespace std;
+
+void NameIndex::normalize(string_view name, string &normalized)
+{
+    normalized.clear();
+    bool space = false;
+    for (char c : name)
+    {
+        if (c == ' ' || c == '\t')
+        {
+            space = !normalized.empty();
+            continue;
+        }
+        if (space)
+        {
+            normalized.push_back(' ');
+            space = false;
+        }
+        //   ASCII (  UTF-8)   
+        normalized.push_back(c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c);
+    }
+}
+
+uint64_t NameIndex::packHead(string_view text)
+{
+    //  ,       
+    uint64_t head = 0;
+    for (size_t i = 0; i < 8; i++)
+    {
+        head <<= 8;
+        if (i < text.size())
+        {
+            head |= static_cast<unsigned char>(text[i]);
+        }
+    }
+    return head;
+}
+
+void NameIndex::add(string_view name, uint32_t key)
+{
+    normalize(name, scratch);
+    Entry entry;
+    entry.head = packHead(scratch);
+    entry.offset = static_cast<uint32_t>(chars.size());
+    entry.length = static_cast<uint32_t>(scratch.size());
+    entry.key = key;
+    chars.insert(chars.end(), scratch.begin(), scratch.end());
+    entries.push_back(entry);
+}
+
+bool NameIndex::less(const Entry &a, const Entry &b) const
+{
+    if (a.head != b.head)
+    {
+        return a.head < b.head;
+    }
+    //  8  :   ,  
+    if (a.length > 8 || b.length > 8)
+    {
+        int order = text(a).compare(text(b));
+        if (order != 0)
+        {
+            return order < 0;
+        }
+    }
+    else if (a.length != b.length)
+    {
+        return a.length < b.length;
+    }
+    return a.key < b.key;
+}
+
+void NameIndex::merge() const
+{
+    if (sortedCount == entries.size())
+    {
+        return;
+    }
+    auto entryLess = [this](const Entry &a, const Entry &b)
+    { return less(a, b); };
+    auto middle = entries.begin() + static_cast<ptrdiff_t>(sortedCount);
+    sort(middle, entries.end(), entryLess);
+    if (sortedCount > 0 && entryLess(*middle, *(middle - 1)))
+    {
+        inplace_merge(entries.begin(), middle, entries.end(), entryLess);
+    }
+    sortedCount = entries.size();
+}
+
+size_t NameIndex::findPrefix(string_view prefix, size_t limit, vector<uint32_t> &keys) const
+{
+    string normalized;
+    normalize(prefix, normalized);
+    merge();
+
+    //      .   -  ',
+    //    ;     8  
+    string_view wanted(normalized);
+    size_t headLength = min<size_t>(wanted.size(), 8);
+    uint64_t head = packHead(wanted);
+    uint64_t headMask = headLength == 0 ? 0 : ~0ull << (8 * (8 - headLength));
+    auto first = partition_point(entries.begin(), entries.end(), [&](const Entry &entry)
+                                 {
+                                     if ((entry.head & headMask) != head)
+                                     {
+                                         return (entry.head & headMask) < head;
+                                     }
+                                     return wanted.size() > 8 && text(entry).compare(0, wanted.size(), wanted) < 0;
+                                 });
+    auto last = partition_point(first, entries.end(), [&](const Entry &entry)
+                                {
+                                    return (entry.head & headMask) == head &&
+                                           (wanted.size() <= 8 || text(entry).compare(0, wanted.size(), wanted) == 0);
+                                });
+    size_t found = static_cast<size_t>(last - first);
+    for (auto entry = first; entry != last && limit > 0; ++entry, limit--)
+    {
+        keys.push_back(entry->key);
+    }
+    return found;
+}
+
+void NameIndex::reserve(size_t count, size_t characters)
+{
+    entries.reserve(count);
+    chars.reserve(characters);
+}
+
+void NameIndex::clear()
+{
+    chars.clear();
+    entries.clear();
+    sortedCount = 0;
+}
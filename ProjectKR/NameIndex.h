@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//   :      
+//  .     8    ,
+//          
+//  .   DateIndex,      ,
+//       ,     
+//    .
+class NameIndex
+{
+public:
+    //  :     ,  
+    //  ,     
+    static void normalize(std::string_view name, std::string &normalized);
+
+    void add(std::string_view name, uint32_t key);
+
+    //  ,    prefix (  ),   keys;
+    //   limit .     .
+    size_t findPrefix(std::string_view prefix, size_t limit, std::vector<uint32_t> &keys) const;
+
+    size_t size() const { return entries.size(); }
+    void reserve(size_t count, size_t characters);
+    void clear();
+
+private:
+    struct Entry
+    {
+        uint64_t head;   //  8   (  - )
+        uint32_t offset; //    chars
+        uint32_t length;
+        uint32_t key;
+    };
+
+    std::vector<char> chars;
+    mutable std::vector<Entry> entries;
+    mutable size_t sortedCount = 0;
+    std::string scratch; //  ,    '   '
+
+    static uint64_t packHead(std::string_view text);
+    std::string_view text(const Entry &entry) const
+    {
+        return std::string_view(chars.data() + entry.offset, entry.length);
+    }
+    bool less(const Entry &a, const Entry &b) const;
+    void merge() const;
+};
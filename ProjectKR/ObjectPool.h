@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <utility>
+#include <vector>
+
+//  ',     2^blockShift .
+// '      (emplace)   
+// :      ,   
+// '  .   ' (handle,   
+// )       clear().
+template <typename T, unsigned blockShift = 12>
+class ObjectPool
+{
+public:
+    static const size_t blockSize = size_t(1) << blockShift;
+
+    //     
+    template <typename Pool, typename Value>
+    class Iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Value value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Value *pointer;
+        typedef Value &reference;
+
+        Iterator(Pool *pool, size_t index) : pool(pool), index(index) {}
+
+        Value &operator*() const { return (*pool)[index]; }
+        Value *operator->() const { return &(*pool)[index]; }
+
+        Iterator &operator++()
+        {
+            index++;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator previous = *this;
+            index++;
+            return previous;
+        }
+
+        bool operator==(const Iterator &other) const { return index == other.index; }
+        bool operator!=(const Iterator &other) const { return index != other.index; }
+
+    private:
+        Pool *pool;
+        size_t index;
+    };
+
+    typedef Iterator<ObjectPool, T> iterator;
+    typedef Iterator<const ObjectPool, const T> const_iterator;
+
+    ObjectPool() : count(0) {}
+
+    ~ObjectPool()
+    {
+        clear();
+        for (T *block : blocks)
+        {
+            ::operator delete(block);
+        }
+    }
+
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool &operator=(const ObjectPool &) = delete;
+
+    //  '   ;   
+    template <typename... Args>
+    uint32_t emplace(Args &&...args)
+    {
+        if (count == blocks.size() * blockSize)
+        {
+            addBlock();
+        }
+        new (slot(count)) T(std::forward<Args>(args)...);
+        return static_cast<uint32_t>(count++);
+    }
+
+    T &operator[](size_t handle) { return *slot(handle); }
+    const T &operator[](size_t handle) const { return *slot(handle); }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    //    n ' ,   
+    //     '   
+    void reserve(size_t n)
+    {
+        while (blocks.size() * blockSize < n)
+        {
+            addBlock();
+        }
+    }
+
+    //   ';      
+    void clear()
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            slot(i)->~T();
+        }
+        count = 0;
+    }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, count); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+
+private:
+    std::vector<T *> blocks; //  '  blockSize ' 
+    size_t count;
+
+    T *slot(size_t handle) const
+    {
+        return blocks[handle >> blockShift] + (handle & (blockSize - 1));
+    }
+
+    void addBlock()
+    {
+        // ̳    -   ,  push_back  
+        //       
+        if (blocks.size() == blocks.capacity())
+        {
+            blocks.reserve(blocks.empty() ? 16 : blocks.size() * 2);
+        }
+        blocks.push_back(static_cast<T *>(::operator new(sizeof(T) * blockSize)));
+    }
+};
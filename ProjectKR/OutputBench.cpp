@@ -0,0 +1,169 @@
+#include "OutputBench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "InternPool.h"
+#include "MappedFile.h"
+#include "OutputBuffer.h"
+#include "PassengerRegistry.h"
+#include "Persistence.h"
+#include "TicketTable.h"
+#include "Validation.h"
+
+using namespace std;
+
+namespace
+{
+    const char *const legacyFilename = "output_bench_legacy.tmp";
+    const char *const bufferedFilename = "output_bench_buffered.tmp";
+
+    //   ,    displayTickets  OutputBuffer
+    void legacyTickets(ostream &file, const PassengerRegistry &passengers, const TicketTable &tickets)
+    {
+        for (const Passenger &passenger : passengers)
+        {
+            file << "Passenger: " << passenger.name << endl;
+            if (passenger.tickets.empty())
+            {
+                file << "No tickets available." << endl;
+            }
+            for (uint32_t row : passenger.tickets)
+            {
+                file << "Ticket ID: " << tickets.id(row) << endl;
+                file << "Ship Name: " << tickets.shipName(row) << endl;
+                file << "Departure Port: " << tickets.departurePort(row) << endl;
+                file << "Destination Port: " << tickets.destinationPort(row) << endl;
+                file << "Date: " << tickets.dateText(row) << endl;
+                file << "Cabin Class: " << tickets.cabinClass(row) << endl;
+                if (tickets.cabin(row) != 0)
+                {
+                    file << "Cabin Number: " << tickets.cabin(row) << endl;
+                }
+                file << "Price: $" << tickets.price(row) << endl;
+                file << endl;
+            }
+        }
+    }
+
+    //   ,    saveDataToFile  ofstream
+    void legacyPassengers(ostream &file, const PassengerRegistry &passengers)
+    {
+        for (const Passenger &passenger : passengers)
+        {
+            file << "Passenger" << endl;
+            file << "Name: " << passenger.name << endl;
+            file << "Address: " << passenger.address << endl;
+            file << "Phone number: " << passenger.phoneNumber << endl;
+            file << "ID: " << passenger.id << endl;
+            file << endl;
+        }
+    }
+
+    bool sameFiles(const char *first, const char *second)
+    {
+        MappedFile a, b;
+        return a.open(first) && b.open(second) && a.size() == b.size() &&
+               (a.size() == 0 || string_view(a.data(), a.size()) == string_view(b.data(), b.size()));
+    }
+
+    //   write  
+    template <typename Write>
+    double timeWrite(Write write)
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        write();
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    void report(ostream &out, const char *name, size_t records, size_t bytes, double legacy, double buffered)
+    {
+        double megabytes = static_cast<double>(bytes) / (1 << 20);
+        out << name << ": " << megabytes << " MB. endl per line: " << legacy << " s ("
+            << static_cast<long long>(records / legacy) << " records/s, " << megabytes / legacy << " MB/s); "
+            << "OutputBuffer: " << buffered << " s (" << static_cast<long long>(records / buffered) << " records/s, "
+            << megabytes / buffered << " MB/s), " << legacy / buffered << "x faster." << '\n';
+    }
+
+    //      ; false,   
+    template <typename Legacy, typename Buffered>
+    bool compare(ostream &out, const char *name, size_t records, Legacy legacy, Buffered buffered)
+    {
+        double legacySeconds = timeWrite([&]
+                                         {
+                                             ofstream file(legacyFilename, ios::binary);
+                                             legacy(file);
+                                         });
+        double bufferedSeconds = timeWrite([&]
+                                           {
+                                               FILE *file = fopen(bufferedFilename, "wb");
+                                               if (file != nullptr)
+                                               {
+                                                   {
+                                                       OutputBuffer buffer(file);
+                                                       buffered(buffer);
+                                                   }
+                                                   fclose(file);
+                                               }
+                                           });
+        MappedFile written;
+        size_t bytes = written.open(bufferedFilename) ? written.size() : 0;
+        written.close();
+        report(out, name, records, bytes, legacySeconds, bufferedSeconds);
+
+        bool same = sameFiles(legacyFilename, bufferedFilename);
+        if (!same)
+        {
+            out << name << ": output differs from the endl version." << '\n';
+        }
+        remove(legacyFilename);
+        remove(bufferedFilename);
+        return same;
+    }
+}
+
+bool runOutputBenchmark(size_t records, ostream &out)
+{
+    //     : 100 , 20 ,   
+    PassengerRegistry passengers;
+    TicketTable tickets;
+    passengers.reserve(records);
+    tickets.reserve(records);
+    uint32_t firstDay = today();
+    for (size_t i = 0; i < records; i++)
+    {
+        int id = static_cast<int>(i + 1);
+        string number = to_string(id);
+        Passenger &passenger = *passengers.emplace("Name " + number, "City " + to_string(i % 1000) + ", street " + number,
+                                                   "+380" + string(9 - min<size_t>(number.size(), 9), '0') + number, id);
+        Voyage route(internPool().intern("Ship" + to_string(i % 100)), internPool().intern("Port" + to_string(i % 20)),
+                     internPool().intern("Port" + to_string((i + 1) % 20)), firstDay + static_cast<uint32_t>(i % 365));
+        int cabinClass = static_cast<int>(i % 3) + 1;
+        passenger.tickets.push_back(tickets.add(id, static_cast<uint32_t>(i % 36500), route, cabinClass,
+                                                static_cast<uint32_t>(i % 6) + 1, 100.0 + static_cast<double>(i % 900) * 0.5));
+    }
+
+    out << "Output benchmark: " << records << " passengers with one ticket each." << '\n';
+    bool ok = compare(out, "Ticket list", records, [&](ostream &file)
+                      { legacyTickets(file, passengers, tickets); },
+                      [&](OutputBuffer &buffer)
+                      {
+                          writePaged(buffer, passengers.size(), 0, cin, [&](string &text, size_t i)
+                                     { formatPassengerTickets(text, passengers[i], tickets); });
+                      });
+    ok = compare(out, "Passenger file", records, [&](ostream &file)
+                 { legacyPassengers(file, passengers); },
+                 [&](OutputBuffer &buffer)
+                 {
+                     for (const Passenger &passenger : passengers)
+                     {
+                         formatPassengerRecord(buffer.text(), passenger);
+                         buffer.commit();
+                     }
+                 }) && ok;
+    return ok;
+}
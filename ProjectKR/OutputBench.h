@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+
+//    ( --bench-output).  records
+//         (
+// "Display tickets")     : ,   
+//   (    ofstream  endl   ),
+//   OutputBuffer.        ,
+//   .  true,      .
+bool runOutputBenchmark(size_t records, std::ostream &out);
@@ -0,0 +1,64 @@
+#include "OutputBuffer.h"
+
+#include <charconv>
+
+#include "Metrics.h"
+
+using namespace std;
+
+void formatInt(string &out, long long value)
+{
+    char buffer[24];
+    to_chars_result result = to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+void formatPrice(string &out, double value)
+{
+    char buffer[32];
+    to_chars_result result = to_chars(buffer, buffer + sizeof(buffer), value, chars_format::general, 6);
+    out.append(buffer, result.ptr);
+}
+
+OutputBuffer::OutputBuffer(FILE *file, size_t chunk) : file(file), chunk(chunk), good(true)
+{
+    //      ,    
+    buffer.reserve(chunk + 4096);
+}
+
+OutputBuffer::~OutputBuffer()
+{
+    flush();
+}
+
+void OutputBuffer::write(const char *data, size_t size)
+{
+    if (size > 0 && fwrite(data, 1, size, file) != size)
+    {
+        good = false;
+    }
+    METRIC_COUNT(BytesWritten, size);
+}
+
+void OutputBuffer::append(string_view data)
+{
+    if (data.size() < chunk)
+    {
+        buffer.append(data.data(), data.size());
+        commit();
+        return;
+    }
+    flush();
+    write(data.data(), data.size());
+}
+
+bool OutputBuffer::flush()
+{
+    write(buffer.data(), buffer.size());
+    buffer.clear();
+    if (fflush(file) != 0)
+    {
+        good = false;
+    }
+    return good;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <istream>
+#include <string>
+#include <string_view>
+
+//      iostream   (std::to_chars).
+// ֳ -   ostream  : 6     .
+void formatInt(std::string &out, long long value);
+void formatPrice(std::string &out, double value);
+
+//    FILE*  .   
+//   -  format*,    
+//   fwrite,    ,   
+//        
+//     endl.
+class OutputBuffer
+{
+public:
+    static const size_t defaultChunk = 1 << 20;
+
+    explicit OutputBuffer(FILE *file, size_t chunk = defaultChunk);
+    ~OutputBuffer();
+
+    OutputBuffer(const OutputBuffer &) = delete;
+    OutputBuffer &operator=(const OutputBuffer &) = delete;
+
+    // ,     
+    std::string &text() { return buffer; }
+
+    //   ;     
+    void append(std::string_view data);
+
+    //  ,     ;    
+    void commit()
+    {
+        if (buffer.size() >= chunk)
+        {
+            flush();
+        }
+    }
+
+    //     fflush; false,       
+    bool flush();
+
+    bool ok() const { return good; }
+
+private:
+    FILE *file;
+    std::string buffer;
+    size_t chunk;
+    bool good;
+
+    void write(const char *data, size_t size);
+};
+
+//   count   : formatRecord(buffer, i)
+//   i. ϳ  pageSize      input
+//  :   -  , -   
+//  - . pageSize 0 -     ( ).
+//    .
+template <typename FormatRecord>
+size_t writePaged(OutputBuffer &out, size_t count, size_t pageSize, std::istream &input, FormatRecord formatRecord)
+{
+    size_t cursor = 0;
+    while (cursor < count)
+    {
+        size_t pageEnd = pageSize == 0 ? count : std::min(count, cursor + pageSize);
+        for (; cursor < pageEnd; cursor++)
+        {
+            formatRecord(out.text(), cursor);
+            out.commit();
+        }
+        if (cursor == count)
+        {
+            break;
+        }
+
+        out.text() += "-- ";
+        formatInt(out.text(), static_cast<long long>(cursor));
+        out.text() += " of ";
+        formatInt(out.text(), static_cast<long long>(count));
+        out.text() += " shown. Press Enter for more or q to stop: ";
+        out.flush();
+        std::string answer;
+        if (!std::getline(input, answer) || !answer.empty())
+        {
+            break;
+        }
+    }
+    out.flush();
+    return cursor;
+}
@@ -0,0 +1,117 @@
+#include "PassengerRegistry.h"
+
+#include <utility>
+
+#include "Validation.h"
+
+using namespace std;
+
+void PassengerRegistry::indexPassenger(const Passenger &passenger, uint32_t slot)
+{
+    //    0,   0  HashIndex 
+    uint64_t phone = parsePhoneNumber(passenger.phoneNumber);
+    if (phone != 0)
+    {
+        phoneIndex.insert(phone, slot);
+    }
+    names.add(passenger.name, slot);
+}
+
+bool PassengerRegistry::reserveId(int id)
+{
+    // ID   >= 1,   0    .
+    //    - ,      .
+    return id >= 1 && idIndex.insert(static_cast<uint64_t>(id), static_cast<uint32_t>(passengers.size()));
+}
+
+Passenger *PassengerRegistry::emplace(string name, string address, string phoneNumber, int id)
+{
+    if (!reserveId(id))
+    {
+        return nullptr;
+    }
+    uint32_t slot = passengers.emplace(move(name), move(address), move(phoneNumber), id);
+    indexPassenger(passengers[slot], slot);
+    return &passengers[slot];
+}
+
+bool PassengerRegistry::add(const Passenger &passenger)
+{
+    if (!reserveId(passenger.id))
+    {
+        return false;
+    }
+    uint32_t slot = passengers.emplace(passenger);
+    indexPassenger(passengers[slot], slot);
+    return true;
+}
+
+bool PassengerRegistry::add(Passenger &&passenger)
+{
+    if (!reserveId(passenger.id))
+    {
+        return false;
+    }
+    uint32_t slot = passengers.emplace(move(passenger));
+    indexPassenger(passengers[slot], slot);
+    return true;
+}
+
+Passenger *PassengerRegistry::find(int id)
+{
+    if (id < 1)
+    {
+        return nullptr;
+    }
+    uint32_t slot = idIndex.find(static_cast<uint64_t>(id));
+    return slot == HashIndex::npos ? nullptr : &passengers[slot];
+}
+
+const Passenger *PassengerRegistry::find(int id) const
+{
+    if (id < 1)
+    {
+        return nullptr;
+    }
+    uint32_t slot = idIndex.find(static_cast<uint64_t>(id));
+    return slot == HashIndex::npos ? nullptr : &passengers[slot];
+}
+
+bool PassengerRegistry::contains(int id) const
+{
+    return id >= 1 && idIndex.contains(static_cast<uint64_t>(id));
+}
+
+Passenger *PassengerRegistry::findByPhone(string_view phoneNumber)
+{
+    uint64_t phone = parsePhoneNumber(phoneNumber);
+    uint32_t slot = phone == 0 ? HashIndex::npos : phoneIndex.find(phone);
+    return slot == HashIndex::npos ? nullptr : &passengers[slot];
+}
+
+const Passenger *PassengerRegistry::findByPhone(string_view phoneNumber) const
+{
+    uint64_t phone = parsePhoneNumber(phoneNumber);
+    uint32_t slot = phone == 0 ? HashIndex::npos : phoneIndex.find(phone);
+    return slot == HashIndex::npos ? nullptr : &passengers[slot];
+}
+
+size_t PassengerRegistry::findByNamePrefix(string_view prefix, size_t limit, vector<const Passenger *> &found) const
+{
+    vector<uint32_t> slots;
+    size_t total = names.findPrefix(prefix, limit, slots);
+    for (uint32_t slot : slots)
+    {
+        found.push_back(&passengers[slot]);
+    }
+    return total;
+}
+
+void PassengerRegistry::reserve(size_t n)
+{
+    passengers.reserve(n);
+    idIndex.reserve(n);
+    phoneIndex.reserve(n);
+    //  16   '
+    names.reserve(n, n * 16);
+}
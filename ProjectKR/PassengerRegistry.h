@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "HashIndex.h"
+#include "Models.h"
+#include "NameIndex.h"
+#include "ObjectPool.h"
+
+//  :     -  ID   
+//   ( +380xxxxxxxxx   64- ) 
+//    .    
+// ,    ID   - O(1)  ,   
+//   -     .
+//    ObjectPool     , 
+//   (handle,    ,   )
+//      ,   .
+class PassengerRegistry
+{
+public:
+    typedef ObjectPool<Passenger>::iterator iterator;
+    typedef ObjectPool<Passenger>::const_iterator const_iterator;
+
+    //     ;    .
+    //  nullptr,     ID   (   ).
+    Passenger *emplace(std::string name, std::string address, std::string phoneNumber, int id);
+
+    //   ;  false,     ID  
+    bool add(const Passenger &passenger);
+    bool add(Passenger &&passenger);
+
+    //    ID, nullptr   
+    Passenger *find(int id);
+    const Passenger *find(int id) const;
+
+    bool contains(int id) const;
+
+    //     , nullptr     
+    // .      ,   .
+    Passenger *findByPhone(std::string_view phoneNumber);
+    const Passenger *findByPhone(std::string_view phoneNumber) const;
+
+    // , '    prefix (   
+    //   ),   ;   limit   
+    // found.    .   
+    // ,         .
+    size_t findByNamePrefix(std::string_view prefix, size_t limit, std::vector<const Passenger *> &found) const;
+
+    //       (0 <= handle < size())
+    Passenger &operator[](size_t handle) { return passengers[handle]; }
+    const Passenger &operator[](size_t handle) const { return passengers[handle]; }
+
+    void reserve(size_t n);
+
+    size_t size() const { return passengers.size(); }
+    bool empty() const { return passengers.empty(); }
+
+    iterator begin() { return passengers.begin(); }
+    iterator end() { return passengers.end(); }
+    const_iterator begin() const { return passengers.begin(); }
+    const_iterator end() const { return passengers.end(); }
+
+private:
+    ObjectPool<Passenger> passengers;
+    HashIndex idIndex;
+    HashIndex phoneIndex;
+    NameIndex names;
+
+    //    ; false,  ID    
+    bool reserveId(int id);
+    void indexPassenger(const Passenger &passenger, uint32_t slot);
+};
@@ -0,0 +1,563 @@
+#include "Persistence.h"
+
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "MappedFile.h"
+#include "Metrics.h"
+#include "Snapshot.h"
+#include "Validation.h"
+
+using namespace std;
+
+namespace
+{
+    //        
+    void syncFile(FILE *file)
+    {
+        if (file == nullptr)
+        {
+            return;
+        }
+        METRIC_TIMER(Fsync);
+        fflush(file);
+#ifdef _WIN32
+        _commit(_fileno(file));
+#else
+        fsync(fileno(file));
+#endif
+    }
+
+    //         
+    void syncPath(const string &filename)
+    {
+        FILE *file = fopen(filename.c_str(), "ab");
+        if (file != nullptr)
+        {
+            syncFile(file);
+            fclose(file);
+        }
+    }
+
+    bool truncateFile(const string &filename)
+    {
+        FILE *file = fopen(filename.c_str(), "wb");
+        if (file == nullptr)
+        {
+            return false;
+        }
+        syncFile(file);
+        return fclose(file) == 0;
+    }
+
+    bool replaceFile(const string &from, const string &to)
+    {
+        error_code error;
+        filesystem::rename(from, to, error);
+        return !error;
+    }
+}
+
+void formatPassengerRecord(string &out, const Passenger &passenger)
+{
+    out += "Passenger\nName: ";
+    out += passenger.name;
+    out += "\nAddress: ";
+    out += passenger.address;
+    out += "\nPhone number: ";
+    out += passenger.phoneNumber;
+    out += "\nID: ";
+    formatInt(out, passenger.id);
+    out += "\n\n";
+}
+
+void formatPassengerInfo(string &out, const Passenger &passenger)
+{
+    out += "\nPassenger information:\nName: ";
+    out += passenger.name;
+    out += "\nAddress: ";
+    out += passenger.address;
+    out += "\nPhone number: ";
+    out += passenger.phoneNumber;
+    out += "\nID: ";
+    formatInt(out, passenger.id);
+    out += "\n\n";
+}
+
+void formatReservationHeader(string &out, const Passenger &passenger)
+{
+    out += "Reservations for Passenger: ";
+    out += passenger.name;
+    out += " (ID: ";
+    formatInt(out, passenger.id);
+    out += ")\n";
+}
+
+void formatTicketRecord(string &out, const TicketFields &ticket)
+{
+    out += "Ticket ID: ";
+    formatInt(out, ticket.id);
+    out += "\nShip Name: ";
+    out += internPool().view(ticket.route.shipId);
+    out += "\nDeparture Port: ";
+    out += internPool().view(ticket.route.departurePort);
+    out += "\nDestination Port: ";
+    out += internPool().view(ticket.route.destinationPort);
+    out += "\nDate: ";
+    formatDate(out, ticket.route.date);
+    out += "\nCabin Class: ";
+    formatInt(out, ticket.cabinClass);
+    if (ticket.cabin != 0)
+    {
+        out += "\nCabin Number: ";
+        formatInt(out, static_cast<int>(ticket.cabin));
+    }
+    out += "\nPrice: $";
+    formatPrice(out, ticket.price);
+    out += "\n\n";
+}
+
+void formatPassengerTickets(string &out, const Passenger &passenger, const TicketTable &tickets)
+{
+    out += "Passenger: ";
+    out += passenger.name;
+    out += '\n';
+    if (passenger.tickets.empty())
+    {
+        out += "No tickets available.\n";
+    }
+    for (uint32_t row : passenger.tickets)
+    {
+        formatTicketRecord(out, tickets.fields(row));
+    }
+}
+
+void formatCabinLayoutRecord(string &out, uint32_t shipId, const CabinLayout &layout)
+{
+    out += "Ship Name: ";
+    out += internPool().view(shipId);
+    out += "\nCabins:";
+    for (uint32_t count : layout.cabins)
+    {
+        out += ' ';
+        formatInt(out, count);
+    }
+    out += "\n\n";
+}
+
+bool writePassengerFile(const PassengerRegistry &passengers, const string &filename)
+{
+    METRIC_TIMER(WritePassengerFile);
+    FILE *file = fopen(filename.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    bool ok;
+    {
+        OutputBuffer out(file);
+        for (const Passenger &passenger : passengers)
+        {
+            formatPassengerRecord(out.text(), passenger);
+            out.commit();
+        }
+        ok = out.flush();
+    }
+    return fclose(file) == 0 && ok;
+}
+
+bool writeReservationFile(const PassengerRegistry &passengers, const TicketTable &tickets, const string &filename)
+{
+    METRIC_TIMER(WriteReservationFile);
+    FILE *file = fopen(filename.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    bool ok;
+    {
+        OutputBuffer out(file);
+        for (const Passenger &passenger : passengers)
+        {
+            if (!passenger.tickets.empty())
+            {
+                formatReservationHeader(out.text(), passenger);
+                for (uint32_t row : passenger.tickets)
+                {
+                    formatTicketRecord(out.text(), tickets.fields(row));
+                }
+                out.commit();
+            }
+        }
+        ok = out.flush();
+    }
+    return fclose(file) == 0 && ok;
+}
+
+bool writeCabinLayoutFile(const ShipInventory &inventory, const string &filename)
+{
+    METRIC_TIMER(WriteCabinLayoutFile);
+    string buffer;
+    for (uint32_t shipId : inventory.customLayouts())
+    {
+        formatCabinLayoutRecord(buffer, shipId, inventory.shipLayout(shipId));
+    }
+    string temp = filename + ".tmp";
+    FILE *file = fopen(temp.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    bool ok = buffer.empty() || fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    ok = fclose(file) == 0 && ok;
+    if (ok)
+    {
+        syncPath(temp);
+    }
+    return ok && replaceFile(temp, filename);
+}
+
+void saveReservationsToFile(const PassengerRegistry &passengers, const TicketTable &tickets, const string &filename)
+{
+    if (!writeReservationFile(passengers, tickets, filename))
+    {
+        cout << "Error opening the file." << endl;
+    }
+}
+
+void saveDataToFile(const PassengerRegistry &passengers, const string &filename)
+{
+    if (!writePassengerFile(passengers, filename))
+    {
+        cout << "Error opening the file." << endl;
+        return;
+    }
+    cout << "Data saved to file successfully." << endl;
+}
+
+void displayDataFromFile(const string &passengerFilename)
+{
+    MappedFile file;
+    if (!file.open(passengerFilename))
+    {
+        cout << "Error opening the file for displaying data." << endl;
+        return;
+    }
+    if (file.size() == 0)
+    {
+        cout << "The file is empty." << endl;
+        return;
+    }
+
+    //     ,      endl
+    cout.flush();
+    {
+        OutputBuffer out(stdout);
+        out.append(string_view(file.data(), file.size()));
+        if (file.data()[file.size() - 1] != '\n')
+        {
+            out.append("\n");
+        }
+    }
+    cout << "Data displayed from file successfully." << endl;
+}
+
+Journal::Journal(const string &passengerFilename, const string &reservationFilename, const JournalOptions &options)
+    : passengerFilename(passengerFilename), reservationFilename(reservationFilename), options(options),
+      passengerFile(nullptr), reservationFile(nullptr), pendingRecords(0), appendedRecords(0), compactedRecords(0),
+      textFailed(false), passengerDirty(false), reservationDirty(false), lastSync(chrono::steady_clock::now()),
+      wal(options.walFilename)
+{
+}
+
+Journal::~Journal()
+{
+    close();
+}
+
+bool Journal::open()
+{
+    close();
+    passengerFile = fopen(passengerFilename.c_str(), "ab");
+    reservationFile = fopen(reservationFilename.c_str(), "ab");
+    if (passengerFile == nullptr || reservationFile == nullptr || (!options.walFilename.empty() && !wal.open()))
+    {
+        close();
+        return false;
+    }
+    //         
+    setvbuf(passengerFile, nullptr, _IOFBF, 1 << 16);
+    setvbuf(reservationFile, nullptr, _IOFBF, 1 << 16);
+    return true;
+}
+
+void Journal::close()
+{
+    if (passengerFile != nullptr || reservationFile != nullptr)
+    {
+        sync();
+    }
+    if (passengerFile != nullptr)
+    {
+        fclose(passengerFile);
+        passengerFile = nullptr;
+    }
+    if (reservationFile != nullptr)
+    {
+        fclose(reservationFile);
+        reservationFile = nullptr;
+    }
+    wal.close();
+}
+
+bool Journal::appendText(FILE *file, const string &record)
+{
+    if (file == nullptr)
+    {
+        return false;
+    }
+    METRIC_TIMER(JournalAppend);
+    if (fwrite(record.data(), 1, record.size(), file) != record.size())
+    {
+        return false;
+    }
+    METRIC_COUNT(BytesWritten, record.size());
+    appendedRecords++;
+    pendingRecords++;
+    (file == passengerFile ? passengerDirty : reservationDirty) = true;
+    afterAppend();
+    return true;
+}
+
+void Journal::afterAppend()
+{
+    switch (options.policy)
+    {
+    case FsyncPolicy::PerRecord:
+        if (options.walFilename.empty())
+        {
+            sync();
+        }
+        //      commit(lsn) ,   ,
+        //         fsync; 
+        //    ,    
+        break;
+    case FsyncPolicy::GroupCommit:
+        if (pendingRecords >= options.groupSize)
+        {
+            sync();
+        }
+        break;
+    case FsyncPolicy::Interval:
+        if (chrono::steady_clock::now() - lastSync >= chrono::milliseconds(options.intervalMs))
+        {
+            sync();
+        }
+        else
+        {
+            //     ,   -   
+            fflush(passengerFile);
+            fflush(reservationFile);
+        }
+        break;
+    }
+}
+
+bool Journal::appendPassenger(const Passenger &passenger)
+{
+    encodePassenger(recordBuffer, passenger);
+    return append(&recordBuffer, 1);
+}
+
+bool Journal::appendReservation(const Passenger &passenger, const TicketFields &ticket)
+{
+    encodeReservation(recordBuffer, passenger, ticket);
+    return append(&recordBuffer, 1);
+}
+
+void Journal::encodePassenger(JournalRecord &record, const Passenger &passenger) const
+{
+    record.reservation = false;
+    if (!options.walFilename.empty())
+    {
+        WriteAheadLog::encodePassenger(record.walRecord, passenger);
+    }
+    record.text.clear();
+    formatPassengerRecord(record.text, passenger);
+}
+
+void Journal::encodeReservation(JournalRecord &record, const Passenger &passenger, const TicketFields &ticket) const
+{
+    record.reservation = true;
+    if (!options.walFilename.empty())
+    {
+        WriteAheadLog::encodeTicket(record.walRecord, passenger, ticket);
+    }
+    record.text.clear();
+    formatReservationHeader(record.text, passenger);
+    formatTicketRecord(record.text, ticket);
+}
+
+bool Journal::append(const JournalRecord *records, size_t count)
+{
+    //     ,       
+    if (!options.walFilename.empty())
+    {
+        walRecords.clear();
+        for (size_t i = 0; i < count; i++)
+        {
+            walRecords.push_back(records[i].walRecord);
+        }
+        if (wal.append(walRecords.data(), count) == 0)
+        {
+            return false;
+        }
+        if (textFailed)
+        {
+            //      ;  
+            //       
+            appendedRecords += count;
+            return true;
+        }
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!appendText(records[i].reservation ? reservationFile : passengerFile, records[i].text))
+        {
+            textFailed = true;
+            appendedRecords += count - i;
+            return !options.walFilename.empty();
+        }
+    }
+    return true;
+}
+
+bool Journal::compactIfNeeded(const PassengerRegistry &passengers, const TicketTable &tickets,
+                              const VoyageTable &voyages)
+{
+    return !needsCompaction() || compact(passengers, tickets, voyages);
+}
+
+void Journal::sync()
+{
+    if (options.walFilename.empty())
+    {
+        // fsync  ,    :   
+        //    fsync    
+        if (passengerDirty)
+        {
+            syncFile(passengerFile);
+        }
+        if (reservationDirty)
+        {
+            syncFile(reservationFile);
+        }
+    }
+    else
+    {
+        //       ;  
+        //  ,      
+        wal.commit(wal.lastLsn());
+        fflush(passengerFile);
+        fflush(reservationFile);
+    }
+    pendingRecords = 0;
+    passengerDirty = false;
+    reservationDirty = false;
+    lastSync = chrono::steady_clock::now();
+}
+
+uint64_t Journal::lastLsn() const
+{
+    return wal.lastLsn();
+}
+
+bool Journal::commit(uint64_t lsn)
+{
+    //             
+    if (options.walFilename.empty() || options.policy != FsyncPolicy::PerRecord)
+    {
+        return true;
+    }
+    return wal.commit(lsn);
+}
+
+bool Journal::needsCompaction() const
+{
+    return textFailed ||
+           (appendedRecords >= options.compactionMinRecords && appendedRecords >= compactedRecords);
+}
+
+bool Journal::saveCabinLayouts(const ShipInventory &inventory)
+{
+    return options.layoutFilename.empty() || writeCabinLayoutFile(inventory, options.layoutFilename);
+}
+
+bool Journal::compact(const PassengerRegistry &passengers, const TicketTable &tickets, const VoyageTable &voyages)
+{
+    close();
+
+    //     -   ,   '
+    bool writeSnapshotFile = !options.snapshotFilename.empty();
+    bool writeText = options.textExport || !writeSnapshotFile;
+    bool ok = true;
+
+    if (writeText)
+    {
+        string passengerTemp = passengerFilename + ".tmp";
+        string reservationTemp = reservationFilename + ".tmp";
+        ok = writePassengerFile(passengers, passengerTemp) &&
+             writeReservationFile(passengers, tickets, reservationTemp);
+        if (ok)
+        {
+            syncPath(passengerTemp);
+            syncPath(reservationTemp);
+        }
+        ok = ok && replaceFile(passengerTemp, passengerFilename) &&
+             replaceFile(reservationTemp, reservationFilename);
+    }
+
+    if (ok && writeSnapshotFile)
+    {
+        //  ',       
+        SnapshotTextState text = {};
+        if (writeText)
+        {
+            text = captureTextState(passengerFilename, reservationFilename);
+        }
+        else
+        {
+            fingerprintTextFile(passengerFilename, 0, text.passengerFingerprint);
+            fingerprintTextFile(reservationFilename, 0, text.reservationFingerprint);
+        }
+        ok = writeSnapshot(options.snapshotFilename, passengers, tickets, voyages, text);
+
+        if (ok && !writeText)
+        {
+            //      ;      
+            //  ,    
+            ok = truncateFile(passengerFilename) && truncateFile(reservationFilename);
+        }
+    }
+
+    if (ok)
+    {
+        //      -   
+        compactedRecords = passengers.size() + tickets.size();
+        appendedRecords = 0;
+        textFailed = false;
+        //          .   
+        //          .
+        ok = options.walFilename.empty() || wal.reset();
+    }
+    return open() && ok;
+}
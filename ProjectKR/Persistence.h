@@ -0,0 +1,166 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Models.h"
+#include "OutputBuffer.h"
+#include "PassengerRegistry.h"
+#include "ShipInventory.h"
+#include "TicketTable.h"
+#include "VoyageTable.h"
+#include "WriteAheadLog.h"
+
+//    -  iostream.
+//  passenger_data.txt:  "Passenger"   Name/Address/Phone number/ID;
+//  reservations.txt:     .
+void formatPassengerRecord(std::string &out, const Passenger &passenger);
+void formatReservationHeader(std::string &out, const Passenger &passenger);
+void formatTicketRecord(std::string &out, const TicketFields &ticket);
+
+//     :    Passenger::displayInfo
+//       ( "Display tickets")
+void formatPassengerInfo(std::string &out, const Passenger &passenger);
+void formatPassengerTickets(std::string &out, const Passenger &passenger, const TicketTable &tickets);
+
+//  ship_layouts.txt:  "Ship Name: X"  "Cabins: <> <> <>"
+void formatCabinLayoutRecord(std::string &out, uint32_t shipId, const CabinLayout &layout);
+
+//       ; false  
+bool writePassengerFile(const PassengerRegistry &passengers, const std::string &filename);
+bool writeReservationFile(const PassengerRegistry &passengers, const TicketTable &tickets, const std::string &filename);
+
+//        
+bool writeCabinLayoutFile(const ShipInventory &inventory, const std::string &filename);
+
+void saveReservationsToFile(const PassengerRegistry &passengers, const TicketTable &tickets, const std::string &filename);
+void saveDataToFile(const PassengerRegistry &passengers, const std::string &filename);
+void displayDataFromFile(const std::string &passengerFilename);
+
+//       (fsync)
+enum class FsyncPolicy
+{
+    PerRecord,   // ϳ  
+    GroupCommit, // ϳ  groupSize 
+    Interval     //  ,    intervalMs 
+};
+
+struct JournalOptions
+{
+    FsyncPolicy policy = FsyncPolicy::GroupCommit;
+    int groupSize = 64;
+    int intervalMs = 1000;
+    // ̳     
+    size_t compactionMinRecords = 1024;
+    //  ,     (  -  )
+    std::string snapshotFilename;
+    //       .   
+    //        ,  .
+    bool textExport = true;
+    //     (  -  )
+    std::string layoutFilename;
+    //    (  -  ).  
+    // fsync      ,   
+    //     .
+    std::string walFilename;
+};
+
+//  ,  ,    
+// (,    - . BackgroundJournal)
+struct JournalRecord
+{
+    bool reservation = false; //  reservations.txt,   passenger_data.txt
+    std::string walRecord;    //     
+    std::string text;         //  
+};
+
+//    :      
+//   passenger_data.txt / reservations.txt     
+//  ,     .
+//   walFilename,     WriteAheadLog (
+//  ),    -   ;  
+//     .
+class Journal
+{
+public:
+    Journal(const std::string &passengerFilename, const std::string &reservationFilename, const JournalOptions &options);
+    ~Journal();
+
+    Journal(const Journal &) = delete;
+    Journal &operator=(const Journal &) = delete;
+
+    // ³     
+    bool open();
+    void close();
+
+    bool appendPassenger(const Passenger &passenger);
+    bool appendReservation(const Passenger &passenger, const TicketFields &ticket);
+
+    //    ;   ,  
+    //    ,  
+    void encodePassenger(JournalRecord &record, const Passenger &passenger) const;
+    void encodeReservation(JournalRecord &record, const Passenger &passenger, const TicketFields &ticket) const;
+
+    //   ;     
+    //     . false -   
+    //     .     
+    //      (   ):
+    //   textExportFailed(),     .
+    bool append(const JournalRecord *records, size_t count);
+
+    //        
+    bool textExportFailed() const { return textFailed; }
+
+    //       
+    bool saveCabinLayouts(const ShipInventory &inventory);
+
+    //       
+    void sync();
+
+    //       (0  )
+    uint64_t lastLsn() const;
+
+    // ϳ  lsn    .  
+    //     PerRecord - ,   
+    //  ;        fsync.
+    //       ,     .
+    bool commit(uint64_t lsn);
+
+    //    :    ,    
+    //   ,      O(1);
+    //     - 
+    bool needsCompaction() const;
+
+    //        ' (   
+    // )    
+    bool compact(const PassengerRegistry &passengers, const TicketTable &tickets,
+                 const VoyageTable &voyages);
+
+    // ,   ; false    
+    bool compactIfNeeded(const PassengerRegistry &passengers, const TicketTable &tickets,
+                         const VoyageTable &voyages);
+
+private:
+    std::string passengerFilename;
+    std::string reservationFilename;
+    JournalOptions options;
+    FILE *passengerFile;
+    FILE *reservationFile;
+    int pendingRecords;     // ,     
+    size_t appendedRecords; //    
+    size_t compactedRecords;
+    bool textFailed;
+    bool passengerDirty;   //     fsync
+    bool reservationDirty;
+    std::chrono::steady_clock::time_point lastSync;
+    JournalRecord recordBuffer; //     
+    std::vector<std::string_view> walRecords;
+    WriteAheadLog wal;
+
+    bool appendText(FILE *file, const std::string &record);
+    void afterAppend();
+};
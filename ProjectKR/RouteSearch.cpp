@@ -0,0 +1,63 @@
+#include "RouteSearch.h"
+
+#include <algorithm>
+
+#include "Metrics.h"
+#include "ThreadPool.h"
+
+using namespace std;
+
+namespace
+{
+    //     :   -   ,
+    //      ,    
+    const size_t morselQueries = 256;
+}
+
+void findSailings(const VoyageTable &voyages, const ShipInventory &inventory, const RouteQuery &query,
+                  vector<Sailing> &sailings)
+{
+    METRIC_TIMER(RouteSearch);
+    auto range = voyages.routeVoyagesBetween(query.departurePort, query.destinationPort, query.from, query.to);
+    for (const uint32_t *voyage = range.first; voyage < range.second; voyage++)
+    {
+        Sailing sailing;
+        sailing.voyageId = *voyage;
+        for (int cabinClass = 1; cabinClass <= cabinClassCount; cabinClass++)
+        {
+            sailing.freeCabins[cabinClass - 1] = static_cast<uint32_t>(inventory.freeCabins(*voyage, cabinClass));
+        }
+        sailings.push_back(sailing);
+    }
+}
+
+void findSailings(const VoyageTable &voyages, const ShipInventory &inventory, const vector<RouteQuery> &queries,
+                  vector<Sailing> &sailings, vector<size_t> &offsets)
+{
+    //      ;   ' 
+    // ,      ,    
+    size_t morsels = (queries.size() + morselQueries - 1) / morselQueries;
+    vector<vector<Sailing>> morselSailings(morsels);
+    offsets.assign(queries.size() + 1, 0);
+    threadPool().parallelFor(queries.size(), morselQueries, [&](size_t, size_t begin, size_t end)
+                             {
+                                 vector<Sailing> &found = morselSailings[begin / morselQueries];
+                                 for (size_t i = begin; i < end; i++)
+                                 {
+                                     findSailings(voyages, inventory, queries[i], found);
+                                     offsets[i + 1] = found.size(); //   -    
+                                 }
+                             });
+
+    sailings.clear();
+    for (size_t morsel = 0; morsel < morsels; morsel++)
+    {
+        size_t base = sailings.size();
+        size_t end = min(queries.size(), (morsel + 1) * morselQueries);
+        for (size_t i = morsel * morselQueries; i < end; i++)
+        {
+            offsets[i + 1] += base;
+        }
+        sailings.insert(sailings.end(), morselSailings[morsel].begin(), morselSailings[morsel].end());
+    }
+}
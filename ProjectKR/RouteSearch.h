@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CabinMap.h"
+#include "ShipInventory.h"
+#include "VoyageTable.h"
+
+//    : "   London  Boston 10/11/25?".
+//      VoyageTable    ,
+//   -   ShipInventory,      
+//  ,   .      
+//    ,    .
+
+// :  -   internPool() (InternPool::npos -  ),
+//  -  ,  
+struct RouteQuery
+{
+    uint32_t departurePort;
+    uint32_t destinationPort;
+    uint32_t from;
+    uint32_t to;
+};
+
+//        
+struct Sailing
+{
+    uint32_t voyageId;
+    uint32_t freeCabins[cabinClassCount];
+};
+
+//        sailings
+void findSailings(const VoyageTable &voyages, const ShipInventory &inventory, const RouteQuery &query,
+                  std::vector<Sailing> &sailings);
+
+//      (  threadPool()):   
+//   sailings ,   i -  offsets[i]  offsets[i + 1]
+void findSailings(const VoyageTable &voyages, const ShipInventory &inventory, const std::vector<RouteQuery> &queries,
+                  std::vector<Sailing> &sailings, std::vector<size_t> &offsets);
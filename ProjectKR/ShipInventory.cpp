@@ -0,0 +1,327 @@
+#include "ShipInventory.h"
+
+#include <algorithm>
+#include <thread>
+
+using namespace std;
+
+namespace
+{
+    //  0 -  ,  1..cabinClassCount - 
+    const int fieldBits = 16;
+    const uint64_t fieldMask = 0xFFFF;
+
+    int field(uint64_t word, int index)
+    {
+        return static_cast<int>((word >> (index * fieldBits)) & fieldMask);
+    }
+
+    //       
+    uint64_t ticketDelta(int cabinClass)
+    {
+        uint64_t delta = 1;
+        if (cabinClass >= 1 && cabinClass <= cabinClassCount)
+        {
+            delta += uint64_t(1) << (cabinClass * fieldBits);
+        }
+        return delta;
+    }
+
+    bool isCabinClass(int cabinClass)
+    {
+        return cabinClass >= 1 && cabinClass <= cabinClassCount;
+    }
+}
+
+ShipInventory::ShipInventory()
+{
+    for (atomic<Slot *> &chunk : chunks)
+    {
+        chunk.store(nullptr, memory_order_relaxed);
+    }
+}
+
+ShipInventory::~ShipInventory()
+{
+    clear();
+}
+
+const ShipInventory::Slot *ShipInventory::find(uint32_t voyageId) const
+{
+    size_t chunk = voyageId / chunkVoyages;
+    if (chunk >= maxChunks)
+    {
+        return nullptr;
+    }
+    const Slot *slots = chunks[chunk].load(memory_order_acquire);
+    return slots == nullptr ? nullptr : &slots[voyageId % chunkVoyages];
+}
+
+ShipInventory::Slot &ShipInventory::slot(uint32_t voyageId)
+{
+    atomic<Slot *> &chunk = chunks[voyageId / chunkVoyages];
+    Slot *slots = chunk.load(memory_order_acquire);
+    if (slots == nullptr)
+    {
+        //    ;    
+        Slot *created = new Slot[chunkVoyages];
+        if (chunk.compare_exchange_strong(slots, created, memory_order_acq_rel, memory_order_acquire))
+        {
+            slots = created;
+        }
+        else
+        {
+            delete[] created;
+        }
+    }
+    return slots[voyageId % chunkVoyages];
+}
+
+ShipCabins &ShipInventory::cabins(Slot &voyage)
+{
+    ShipCabins *existing = voyage.cabins.load(memory_order_acquire);
+    if (existing == nullptr)
+    {
+        ShipCabins *created = new ShipCabins(defaultCabinLayout);
+        if (voyage.cabins.compare_exchange_strong(existing, created, memory_order_acq_rel, memory_order_acquire))
+        {
+            existing = created;
+        }
+        else
+        {
+            delete created;
+        }
+    }
+    return *existing;
+}
+
+uint64_t ShipInventory::load(uint32_t voyageId) const
+{
+    const Slot *occupancy = find(voyageId);
+    return occupancy == nullptr ? 0 : occupancy->word.load(memory_order_acquire);
+}
+
+bool ShipInventory::setLayout(uint32_t shipId, const CabinLayout &layout)
+{
+    if (!layout.isValid())
+    {
+        return false;
+    }
+    if (layouts.insert_or_assign(shipId, layout).second)
+    {
+        configuredShips.push_back(shipId);
+    }
+    return true;
+}
+
+CabinLayout ShipInventory::shipLayout(uint32_t shipId) const
+{
+    auto configured = layouts.find(shipId);
+    return configured == layouts.end() ? defaultCabinLayout : configured->second;
+}
+
+void ShipInventory::openVoyage(uint32_t voyageId, uint32_t shipId)
+{
+    if (voyageId / chunkVoyages >= maxChunks)
+    {
+        return;
+    }
+    Slot &voyage = slot(voyageId);
+    delete voyage.cabins.exchange(new ShipCabins(shipLayout(shipId)), memory_order_acq_rel);
+}
+
+CabinLayout ShipInventory::layout(uint32_t voyageId) const
+{
+    const Slot *voyage = find(voyageId);
+    const ShipCabins *voyageCabins = voyage == nullptr ? nullptr : voyage->cabins.load(memory_order_acquire);
+    return voyageCabins == nullptr ? defaultCabinLayout : voyageCabins->layout;
+}
+
+int ShipInventory::capacity(uint32_t voyageId) const
+{
+    return static_cast<int>(layout(voyageId).total());
+}
+
+int ShipInventory::passengersOnVoyage(uint32_t voyageId) const
+{
+    return field(load(voyageId), 0);
+}
+
+int ShipInventory::passengersInClass(uint32_t voyageId, int cabinClass) const
+{
+    if (!isCabinClass(cabinClass))
+    {
+        return 0;
+    }
+    return field(load(voyageId), cabinClass);
+}
+
+int ShipInventory::freeCabins(uint32_t voyageId, int cabinClass) const
+{
+    if (!isCabinClass(cabinClass))
+    {
+        return 0;
+    }
+    int free = static_cast<int>(layout(voyageId).cabins[cabinClass - 1]) - passengersInClass(voyageId, cabinClass);
+    return max(free, 0);
+}
+
+bool ShipInventory::isVoyageFull(uint32_t voyageId) const
+{
+    return passengersOnVoyage(voyageId) >= capacity(voyageId);
+}
+
+bool ShipInventory::isClassFull(uint32_t voyageId, int cabinClass) const
+{
+    return freeCabins(voyageId, cabinClass) == 0;
+}
+
+bool ShipInventory::isCabinFree(uint32_t voyageId, uint32_t cabin) const
+{
+    const Slot *voyage = find(voyageId);
+    const ShipCabins *voyageCabins = voyage == nullptr ? nullptr : voyage->cabins.load(memory_order_acquire);
+    CabinLayout voyageLayout = voyageCabins == nullptr ? defaultCabinLayout : voyageCabins->layout;
+    int cabinClass = voyageLayout.classOf(cabin);
+    if (cabinClass == 0)
+    {
+        return false;
+    }
+    return voyageCabins == nullptr || voyageCabins->classes[cabinClass - 1].isFree(cabin - voyageLayout.firstCabin(cabinClass));
+}
+
+uint32_t ShipInventory::recordTicket(uint32_t voyageId, int cabinClass, uint32_t cabin)
+{
+    if (voyageId / chunkVoyages >= maxChunks)
+    {
+        return 0;
+    }
+    Slot &voyage = slot(voyageId);
+    //     ,     
+    if (field(voyage.word.load(memory_order_acquire), 0) == static_cast<int>(fieldMask))
+    {
+        return 0;
+    }
+    voyage.word.fetch_add(ticketDelta(cabinClass), memory_order_acq_rel);
+    if (!isCabinClass(cabinClass))
+    {
+        return 0;
+    }
+
+    ShipCabins &voyageCabins = cabins(voyage);
+    CabinBitmap &bitmap = voyageCabins.classes[cabinClass - 1];
+    uint32_t first = voyageCabins.layout.firstCabin(cabinClass);
+    if (cabin >= first && bitmap.take(cabin - first))
+    {
+        return cabin;
+    }
+    uint32_t index = bitmap.takeFirst();
+    return index == CabinBitmap::npos ? 0 : first + index;
+}
+
+SeatReservation ShipInventory::tryReserve(uint32_t voyageId, int cabinClass, uint32_t cabin, uint32_t &assigned)
+{
+    assigned = 0;
+    if (!isCabinClass(cabinClass))
+    {
+        return SeatReservation::ClassFull;
+    }
+    if (voyageId / chunkVoyages >= maxChunks)
+    {
+        return SeatReservation::ShipFull;
+    }
+    Slot &voyage = slot(voyageId);
+    ShipCabins &voyageCabins = cabins(voyage);
+    const CabinLayout &voyageLayout = voyageCabins.layout;
+    uint32_t first = voyageLayout.firstCabin(cabinClass);
+    if (cabin != 0 && voyageLayout.classOf(cabin) != cabinClass)
+    {
+        return SeatReservation::InvalidCabin;
+    }
+
+    //     :   
+    //   ,       ShipFull
+    //  ClassFull    
+    CabinBitmap &bitmap = voyageCabins.classes[cabinClass - 1];
+    if (cabin != 0 && !bitmap.take(cabin - first))
+    {
+        return SeatReservation::CabinTaken;
+    }
+
+    // ˳        compare-and-swap
+    int voyageCapacity = static_cast<int>(voyageLayout.total());
+    int classLimit = static_cast<int>(voyageLayout.cabins[cabinClass - 1]);
+    uint64_t current = voyage.word.load(memory_order_acquire);
+    uint64_t delta = ticketDelta(cabinClass);
+    do
+    {
+        SeatReservation full = SeatReservation::Reserved;
+        if (field(current, 0) >= voyageCapacity)
+        {
+            full = SeatReservation::ShipFull;
+        }
+        else if (field(current, cabinClass) >= classLimit)
+        {
+            full = SeatReservation::ClassFull;
+        }
+        if (full != SeatReservation::Reserved)
+        {
+            if (cabin != 0)
+            {
+                bitmap.release(cabin - first);
+            }
+            return full;
+        }
+    } while (!voyage.word.compare_exchange_weak(current, current + delta, memory_order_acq_rel, memory_order_acquire));
+
+    if (cabin != 0)
+    {
+        assigned = cabin;
+        return SeatReservation::Reserved;
+    }
+
+    // ̳   ,       
+    // ':        , 
+    // compare-and-swap  ,  release,    .
+    //    ,   .
+    uint32_t index;
+    while ((index = bitmap.takeFirst()) == CabinBitmap::npos)
+    {
+        this_thread::yield();
+    }
+    assigned = first + index;
+    return SeatReservation::Reserved;
+}
+
+void ShipInventory::release(uint32_t voyageId, int cabinClass, uint32_t cabin)
+{
+    if (find(voyageId) == nullptr)
+    {
+        return;
+    }
+    Slot &voyage = slot(voyageId);
+    voyage.word.fetch_sub(ticketDelta(cabinClass), memory_order_acq_rel);
+    ShipCabins *voyageCabins = voyage.cabins.load(memory_order_acquire);
+    if (voyageCabins != nullptr && isCabinClass(cabinClass) && voyageCabins->layout.classOf(cabin) == cabinClass)
+    {
+        voyageCabins->classes[cabinClass - 1].release(cabin - voyageCabins->layout.firstCabin(cabinClass));
+    }
+}
+
+void ShipInventory::clear()
+{
+    for (atomic<Slot *> &chunk : chunks)
+    {
+        Slot *slots = chunk.exchange(nullptr, memory_order_acq_rel);
+        if (slots == nullptr)
+        {
+            continue;
+        }
+        for (size_t i = 0; i < chunkVoyages; i++)
+        {
+            delete slots[i].cabins.load(memory_order_relaxed);
+        }
+        delete[] slots;
+    }
+    layouts.clear();
+    configuredShips.clear();
+}
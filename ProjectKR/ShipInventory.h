@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "CabinMap.h"
+
+//    
+enum class SeatReservation
+{
+    Reserved,
+    ShipFull,
+    ClassFull,
+    CabinTaken,  //    
+    InvalidCabin //        
+};
+
+//   ,      ,
+//        .
+//     VoyageTable,  -    internPool().
+//
+//      (  defaultCabinLayout), 
+//   -         
+//   . ʳ  
+//    64-   ( 16    
+//    ),  tryReserve      
+// compare-and-swap  ,       .
+//       ,    
+//    . '  ,   ,
+//          .
+// setLayout,     clear() -    .
+class ShipInventory
+{
+public:
+    ShipInventory();
+    ~ShipInventory();
+
+    ShipInventory(const ShipInventory &) = delete;
+    ShipInventory &operator=(const ShipInventory &) = delete;
+
+    //      ,   ;
+    // false,   .    
+    //  ,  ,   (configureShipLayout).
+    bool setLayout(uint32_t shipId, const CabinLayout &layout);
+    CabinLayout shipLayout(uint32_t shipId) const;
+
+    //       
+    const std::vector<uint32_t> &customLayouts() const { return configuredShips; }
+
+    // ³      .  
+    //       .
+    void openVoyage(uint32_t voyageId, uint32_t shipId);
+
+    CabinLayout layout(uint32_t voyageId) const;
+    int capacity(uint32_t voyageId) const;
+    int passengersOnVoyage(uint32_t voyageId) const;
+    int passengersInClass(uint32_t voyageId, int cabinClass) const;
+    int freeCabins(uint32_t voyageId, int cabinClass) const;
+
+    bool isVoyageFull(uint32_t voyageId) const;
+    bool isClassFull(uint32_t voyageId, int cabinClass) const;
+    bool isCabinFree(uint32_t voyageId, uint32_t cabin) const;
+
+    //       .  , 
+    //  ;  ( cabin == 0) -    .
+    //     0,    .
+    uint32_t recordTicket(uint32_t voyageId, int cabinClass, uint32_t cabin = 0);
+
+    //   ,      ,  
+    // . cabin == 0 -    ,  -   .
+    //     assigned.
+    SeatReservation tryReserve(uint32_t voyageId, int cabinClass, uint32_t cabin, uint32_t &assigned);
+
+    //      O(1),    
+    void release(uint32_t voyageId, int cabinClass, uint32_t cabin);
+
+    void clear();
+
+private:
+    struct alignas(64) Slot
+    {
+        std::atomic<uint64_t> word{0};
+        std::atomic<ShipCabins *> cabins{nullptr};
+    };
+
+    static const size_t chunkVoyages = 4096; //    
+    static const size_t maxChunks = 4096;    //  16M 
+
+    std::atomic<Slot *> chunks[maxChunks];
+    std::unordered_map<uint32_t, CabinLayout> layouts;
+    std::vector<uint32_t> configuredShips;
+
+    const Slot *find(uint32_t voyageId) const;
+    Slot &slot(uint32_t voyageId);
+    uint64_t load(uint32_t voyageId) const;
+
+    //  ;       
+    ShipCabins &cabins(Slot &voyage);
+};
@@ -0,0 +1,422 @@
+#include "Snapshot.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "InternPool.h"
+#include "Metrics.h"
+#include "Validation.h"
+
+using namespace std;
+
+namespace
+{
+    const uint64_t fingerprintWindow = 4096;
+
+    // FNV-1a, 64 
+    uint64_t hashBytes(const char *data, size_t size)
+    {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+    uint64_t fileSize(const string &filename)
+    {
+        error_code error;
+        uintmax_t size = filesystem::file_size(filename, error);
+        return error ? 0 : static_cast<uint64_t>(size);
+    }
+
+    //  ,      .
+    //  ,    ,    .
+    class StringTableBuilder
+    {
+    public:
+        SnapshotString add(string_view value)
+        {
+            SnapshotString ref;
+            ref.offset = bytes.size();
+            ref.length = static_cast<uint32_t>(value.size());
+            ref.reserved = 0;
+            bytes.insert(bytes.end(), value.begin(), value.end());
+            return ref;
+        }
+
+        SnapshotString addShared(string_view value)
+        {
+            string key(value);
+            auto it = shared.find(key);
+            if (it != shared.end())
+            {
+                return it->second;
+            }
+            SnapshotString ref = add(value);
+            shared.emplace(move(key), ref);
+            return ref;
+        }
+
+        const vector<char> &data() const { return bytes; }
+
+    private:
+        vector<char> bytes;
+        unordered_map<string, SnapshotString> shared;
+    };
+
+    //          .
+    //       ,    
+    //     .
+    class SnapshotNameCache
+    {
+    public:
+        explicit SnapshotNameCache(const SnapshotView &snapshot) : snapshot(snapshot) {}
+
+        uint32_t name(const SnapshotString &ref)
+        {
+            auto cached = names.find(ref.offset);
+            if (cached != names.end())
+            {
+                return cached->second;
+            }
+            uint32_t id = internPool().intern(snapshot.text(ref));
+            names.emplace(ref.offset, id);
+            return id;
+        }
+
+        //    0,      
+        uint32_t date(const SnapshotString &ref)
+        {
+            auto cached = dates.find(ref.offset);
+            if (cached != dates.end())
+            {
+                return cached->second;
+            }
+            Date parsed;
+            uint32_t packed = parseStoredDate(snapshot.text(ref), parsed) ? packDate(parsed) : 0;
+            dates.emplace(ref.offset, packed);
+            return packed;
+        }
+
+    private:
+        const SnapshotView &snapshot;
+        unordered_map<uint64_t, uint32_t> names;
+        unordered_map<uint64_t, uint32_t> dates;
+    };
+
+    bool seekTo(FILE *file, uint64_t offset)
+    {
+#ifdef _WIN32
+        return _fseeki64(file, static_cast<long long>(offset), SEEK_SET) == 0;
+#else
+        return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+    }
+
+    bool writeBytes(FILE *file, const void *data, size_t size)
+    {
+        METRIC_COUNT(BytesWritten, size);
+        return size == 0 || fwrite(data, 1, size, file) == size;
+    }
+
+    template <typename T>
+    bool writeRecords(FILE *file, const vector<T> &records)
+    {
+        return writeBytes(file, records.data(), records.size() * sizeof(T));
+    }
+
+    bool syncAndClose(FILE *file)
+    {
+        METRIC_TIMER(Fsync);
+        bool ok = fflush(file) == 0;
+#ifdef _WIN32
+        ok = _commit(_fileno(file)) == 0 && ok;
+#else
+        ok = fsync(fileno(file)) == 0 && ok;
+#endif
+        return fclose(file) == 0 && ok;
+    }
+}
+
+bool fingerprintTextFile(const string &filename, uint64_t size, uint64_t &fingerprint)
+{
+    if (size == 0)
+    {
+        fingerprint = hashBytes(nullptr, 0);
+        return true;
+    }
+    if (fileSize(filename) < size)
+    {
+        return false;
+    }
+    FILE *file = fopen(filename.c_str(), "rb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    uint64_t window = size < fingerprintWindow ? size : fingerprintWindow;
+    vector<char> buffer(static_cast<size_t>(window));
+    bool ok = seekTo(file, size - window) &&
+              fread(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    fclose(file);
+    if (ok)
+    {
+        fingerprint = hashBytes(buffer.data(), buffer.size());
+    }
+    return ok;
+}
+
+SnapshotTextState captureTextState(const string &passengerFilename, const string &reservationFilename)
+{
+    SnapshotTextState state;
+    state.passengerFileSize = fileSize(passengerFilename);
+    state.reservationFileSize = fileSize(reservationFilename);
+    if (!fingerprintTextFile(passengerFilename, state.passengerFileSize, state.passengerFingerprint))
+    {
+        state.passengerFileSize = 0;
+        fingerprintTextFile(passengerFilename, 0, state.passengerFingerprint);
+    }
+    if (!fingerprintTextFile(reservationFilename, state.reservationFileSize, state.reservationFingerprint))
+    {
+        state.reservationFileSize = 0;
+        fingerprintTextFile(reservationFilename, 0, state.reservationFingerprint);
+    }
+    return state;
+}
+
+bool writeSnapshot(const string &filename, const PassengerRegistry &passengers, const TicketTable &tickets,
+                   const VoyageTable &voyages, const SnapshotTextState &text)
+{
+    METRIC_TIMER(WriteSnapshot);
+    StringTableBuilder strings;
+    vector<SnapshotPassenger> passengerRecords;
+    vector<SnapshotTicket> ticketRecords;
+    vector<SnapshotVoyage> voyageRecords;
+    passengerRecords.reserve(passengers.size());
+    ticketRecords.reserve(tickets.size());
+
+    //              
+    const InternPool &pool = internPool();
+    vector<SnapshotString> nameRefs(pool.size());
+    vector<uint8_t> nameAdded(pool.size(), 0);
+    auto nameRef = [&](uint32_t id)
+    {
+        if (!nameAdded[id])
+        {
+            nameRefs[id] = strings.addShared(pool.view(id));
+            nameAdded[id] = 1;
+        }
+        return nameRefs[id];
+    };
+    unordered_map<uint32_t, SnapshotString> dateRefs;
+    string dateText;
+    auto dateRef = [&](uint32_t date)
+    {
+        auto existing = dateRefs.find(date);
+        if (existing == dateRefs.end())
+        {
+            dateText.clear();
+            formatDate(dateText, date);
+            existing = dateRefs.emplace(date, strings.addShared(dateText)).first;
+        }
+        return existing->second;
+    };
+
+    for (const Passenger &passenger : passengers)
+    {
+        SnapshotPassenger record;
+        record.id = passenger.id;
+        record.ticketCount = static_cast<uint32_t>(passenger.tickets.size());
+        record.firstTicket = ticketRecords.size();
+        record.name = strings.add(passenger.name);
+        record.address = strings.add(passenger.address);
+        record.phoneNumber = strings.add(passenger.phoneNumber);
+        passengerRecords.push_back(record);
+
+        for (uint32_t row : passenger.tickets)
+        {
+            SnapshotTicket ticketRecord;
+            ticketRecord.id = tickets.id(row);
+            ticketRecord.passengerId = passenger.id;
+            ticketRecord.cabinClass = tickets.cabinClass(row);
+            ticketRecord.cabin = tickets.cabin(row);
+            ticketRecord.price = tickets.price(row);
+            ticketRecord.shipName = nameRef(tickets.shipId(row));
+            ticketRecord.departurePort = nameRef(tickets.departureId(row));
+            ticketRecord.destinationPort = nameRef(tickets.destinationId(row));
+            ticketRecord.date = dateRef(tickets.date(row));
+            ticketRecords.push_back(ticketRecord);
+        }
+    }
+
+    //    ,     
+    voyageRecords.reserve(voyages.size());
+    for (uint32_t voyageId = 0; voyageId < voyages.size(); voyageId++)
+    {
+        const Voyage &voyage = voyages.voyage(voyageId);
+        SnapshotVoyage record;
+        record.name = nameRef(voyage.shipId);
+        record.departurePort = nameRef(voyage.departurePort);
+        record.destinationPort = nameRef(voyage.destinationPort);
+        record.date = dateRef(voyage.date);
+        voyageRecords.push_back(record);
+    }
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, snapshotMagic, sizeof(header.magic));
+    header.version = snapshotVersion;
+    header.headerSize = sizeof(SnapshotHeader);
+    header.passengerCount = passengerRecords.size();
+    header.ticketCount = ticketRecords.size();
+    header.voyageCount = voyageRecords.size();
+    header.passengerOffset = sizeof(SnapshotHeader);
+    header.ticketOffset = header.passengerOffset + passengerRecords.size() * sizeof(SnapshotPassenger);
+    header.voyageOffset = header.ticketOffset + ticketRecords.size() * sizeof(SnapshotTicket);
+    header.stringOffset = header.voyageOffset + voyageRecords.size() * sizeof(SnapshotVoyage);
+    header.stringSize = strings.data().size();
+    header.text = text;
+
+    string tempFilename = filename + ".tmp";
+    FILE *file = fopen(tempFilename.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    bool ok = writeBytes(file, &header, sizeof(header)) &&
+              writeRecords(file, passengerRecords) &&
+              writeRecords(file, ticketRecords) &&
+              writeRecords(file, voyageRecords) &&
+              writeRecords(file, strings.data());
+    ok = syncAndClose(file) && ok;
+    if (!ok)
+    {
+        remove(tempFilename.c_str());
+        return false;
+    }
+
+    error_code error;
+    filesystem::rename(tempFilename, filename, error);
+    return !error;
+}
+
+bool SnapshotView::open(const string &filename)
+{
+    if (!file.open(filename))
+    {
+        return false;
+    }
+    if (file.size() < sizeof(SnapshotHeader))
+    {
+        file.close();
+        return false;
+    }
+
+    // ,        
+    const SnapshotHeader &h = header();
+    uint64_t size = file.size();
+    bool valid = memcmp(h.magic, snapshotMagic, sizeof(h.magic)) == 0 &&
+                 h.version == snapshotVersion &&
+                 h.headerSize == sizeof(SnapshotHeader) &&
+                 h.passengerOffset <= size && h.passengerCount <= (size - h.passengerOffset) / sizeof(SnapshotPassenger) &&
+                 h.ticketOffset <= size && h.ticketCount <= (size - h.ticketOffset) / sizeof(SnapshotTicket) &&
+                 h.voyageOffset <= size && h.voyageCount <= (size - h.voyageOffset) / sizeof(SnapshotVoyage) &&
+                 h.stringOffset <= size && h.stringSize <= size - h.stringOffset;
+    if (!valid)
+    {
+        file.close();
+    }
+    return valid;
+}
+
+string_view SnapshotView::text(const SnapshotString &ref) const
+{
+    const SnapshotHeader &h = header();
+    if (ref.offset > h.stringSize || ref.length > h.stringSize - ref.offset)
+    {
+        return string_view();
+    }
+    return string_view(file.data() + h.stringOffset + ref.offset, ref.length);
+}
+
+void restoreFromSnapshot(const SnapshotView &snapshot, PassengerRegistry &passengers, TicketTable &tickets, IdRegistry &usedIds,
+                         IdRegistry &usedTicketIds, VoyageTable &voyages,
+                         ShipInventory &inventory, LoadStats &stats)
+{
+    passengers.reserve(passengers.size() + snapshot.passengerCount());
+    tickets.reserve(tickets.size() + snapshot.ticketCount());
+    voyages.reserve(voyages.size() + snapshot.voyageCount());
+    SnapshotNameCache names(snapshot);
+
+    //    ,      
+    auto addVoyage = [&](uint32_t ship, uint32_t departure, uint32_t destination, uint32_t date)
+    {
+        size_t knownVoyages = voyages.size();
+        uint32_t voyageId = voyages.add(ship, departure, destination, date);
+        if (voyages.size() != knownVoyages)
+        {
+            inventory.openVoyage(voyageId, ship);
+        }
+        return voyageId;
+    };
+    for (size_t i = 0; i < snapshot.voyageCount(); i++)
+    {
+        const SnapshotVoyage &voyage = snapshot.voyage(i);
+        uint32_t date = names.date(voyage.date);
+        if (date != 0)
+        {
+            addVoyage(names.name(voyage.name), names.name(voyage.departurePort), names.name(voyage.destinationPort), date);
+        }
+    }
+
+    for (size_t i = 0; i < snapshot.passengerCount(); i++)
+    {
+        const SnapshotPassenger &record = snapshot.passenger(i);
+        if (record.id < 1 || passengers.contains(record.id))
+        {
+            stats.skippedRecords++;
+            continue;
+        }
+        uint64_t lastTicket = record.firstTicket + record.ticketCount;
+        if (lastTicket > snapshot.ticketCount())
+        {
+            stats.skippedRecords++;
+            continue;
+        }
+        //     ,      
+        Passenger &passenger = *passengers.emplace(string(snapshot.text(record.name)), string(snapshot.text(record.address)),
+                                                   string(snapshot.text(record.phoneNumber)), record.id);
+        for (uint64_t t = record.firstTicket; t < lastTicket; t++)
+        {
+            const SnapshotTicket &ticket = snapshot.ticket(static_cast<size_t>(t));
+            uint32_t date = names.date(ticket.date);
+            if (date == 0 || !usedTicketIds.insert(ticket.id))
+            {
+                stats.skippedRecords++;
+                continue;
+            }
+            Voyage route(names.name(ticket.shipName), names.name(ticket.departurePort),
+                         names.name(ticket.destinationPort), date);
+            uint32_t voyageId = addVoyage(route.shipId, route.departurePort, route.destinationPort, date);
+            uint32_t cabin = inventory.recordTicket(voyageId, ticket.cabinClass, ticket.cabin);
+            passenger.tickets.push_back(tickets.add(ticket.id, voyageId, route, ticket.cabinClass, cabin, ticket.price));
+            stats.tickets++;
+        }
+
+        usedIds.insert(record.id);
+        stats.passengers++;
+    }
+}
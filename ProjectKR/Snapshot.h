@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "DataLoader.h"
+#include "IdRegistry.h"
+#include "MappedFile.h"
+#include "Models.h"
+#include "PassengerRegistry.h"
+#include "ShipInventory.h"
+#include "TicketTable.h"
+#include "VoyageTable.h"
+
+//     ( 1).
+//  : ,     (,
+// , )   .      x86/x64,
+//    8 ,       mmap.
+
+const char snapshotMagic[8] = {'K', 'R', 'S', 'N', 'A', 'P', '0', '1'};
+const uint32_t snapshotVersion = 1;
+
+//      
+struct SnapshotString
+{
+    uint64_t offset;
+    uint32_t length;
+    uint32_t reserved;
+};
+
+struct SnapshotPassenger
+{
+    int32_t id;
+    uint32_t ticketCount;
+    uint64_t firstTicket; //       
+    SnapshotString name;
+    SnapshotString address;
+    SnapshotString phoneNumber;
+};
+
+struct SnapshotTicket
+{
+    int32_t id;
+    int32_t passengerId;
+    int32_t cabinClass;
+    uint32_t cabin; // 0     
+    double price;
+    SnapshotString shipName;
+    SnapshotString departurePort;
+    SnapshotString destinationPort;
+    SnapshotString date;
+};
+
+//  ;      (   
+//  -  )
+struct SnapshotVoyage
+{
+    SnapshotString name;
+    SnapshotString departurePort;
+    SnapshotString destinationPort;
+    SnapshotString date;
+};
+
+//      :    
+//       .
+// ³ -     ,    .
+struct SnapshotTextState
+{
+    uint64_t passengerFileSize;
+    uint64_t reservationFileSize;
+    uint64_t passengerFingerprint;
+    uint64_t reservationFingerprint;
+};
+
+struct SnapshotHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t passengerCount;
+    uint64_t ticketCount;
+    uint64_t voyageCount;
+    uint64_t passengerOffset;
+    uint64_t ticketOffset;
+    uint64_t voyageOffset;
+    uint64_t stringOffset;
+    uint64_t stringSize;
+    SnapshotTextState text;
+};
+
+// ³  size    (   4 );
+// false,     size
+bool fingerprintTextFile(const std::string &filename, uint64_t size, uint64_t &fingerprint);
+
+//        
+SnapshotTextState captureTextState(const std::string &passengerFilename, const std::string &reservationFilename);
+
+//       
+bool writeSnapshot(const std::string &filename, const PassengerRegistry &passengers, const TicketTable &tickets,
+                   const VoyageTable &voyages, const SnapshotTextState &text);
+
+// ,   mmap:      '
+class SnapshotView
+{
+public:
+    bool open(const std::string &filename);
+    void close() { file.close(); }
+
+    const SnapshotHeader &header() const { return *reinterpret_cast<const SnapshotHeader *>(file.data()); }
+
+    size_t passengerCount() const { return static_cast<size_t>(header().passengerCount); }
+    size_t ticketCount() const { return static_cast<size_t>(header().ticketCount); }
+    size_t voyageCount() const { return static_cast<size_t>(header().voyageCount); }
+
+    const SnapshotPassenger &passenger(size_t i) const { return records<SnapshotPassenger>(header().passengerOffset)[i]; }
+    const SnapshotTicket &ticket(size_t i) const { return records<SnapshotTicket>(header().ticketOffset)[i]; }
+    const SnapshotVoyage &voyage(size_t i) const { return records<SnapshotVoyage>(header().voyageOffset)[i]; }
+
+    //    ;     
+    std::string_view text(const SnapshotString &ref) const;
+
+private:
+    MappedFile file;
+
+    template <typename T>
+    const T *records(uint64_t offset) const
+    {
+        return reinterpret_cast<const T *>(file.data() + offset);
+    }
+};
+
+// ³ ,  , usedIds, usedTicketIds,  
+//    
+void restoreFromSnapshot(const SnapshotView &snapshot, PassengerRegistry &passengers, TicketTable &tickets,
+                         IdRegistry &usedIds, IdRegistry &usedTicketIds, VoyageTable &voyages,
+                         ShipInventory &inventory, LoadStats &stats);
@@ -1,146 +1,37 @@
 #include <iostream>
 #include <fstream>
+#include <cstdlib>
 #include <vector>
 #include <string>
 #include <map> //  
-#include <set>
-#include <regex> //    
+#include <algorithm>
+#include <limits>
 #include <sstream>
 
-using namespace std;
-
-// ,    ( )
-class Person
-{
-public:
-    string name;
-    string phoneNumber;
-
-    //  Person
-    Person(const string &n, const string &phone) : name(n), phoneNumber(phone) {}
-
-    //        
-    virtual void displayInfo() const = 0;
-};
-
-//    
-class Ticket
-{
-public:
-    int id;
-    string shipName; //    
-    string departurePort;
-    string destinationPort;
-    string date;
-    int cabinClass;
-    double price;
-
-    Ticket(int i, const string &depart, const string &dest, const string &d, int cabin, double p, const string &ship)
-    {
-        id = i;
-        shipName = ship;
-        departurePort = depart;
-        destinationPort = dest;
-        date = d;
-        cabinClass = cabin;
-        price = p;
-    }
-};
-
-//    ,   
-class Passenger : public Person
-{
-public:
-    int id;
-    string address;
-    vector<Ticket> tickets;
-
-    Passenger(const string &n, const string &addr, const string &phone, int i) : Person(n, phone), id(i), address(addr) {}
-
-    //      
-    void displayInfo() const override
-    {
-        cout << endl;
-        cout << "Passenger information:" << endl;
-        cout << "Name: " << name << endl;
-        cout << "Address: " << address << endl;
-        cout << "Phone number: " << phoneNumber << endl;
-        cout << "ID: " << id << endl;
-        cout << endl;
-    }
-};
-
-bool isValidPhoneNumber(const string &number)
-{
-    //        (+380xxxxxxxxx)
-    regex pattern("^\\+380\\d{9}$");
-    return regex_match(number, pattern);
-}
-
-bool isValidDate(const string &date)
-{
-    regex pattern("^\\d{2}/\\d{2}/\\d{2}$");
-
-    if (!regex_match(date, pattern))
-    {
-        return false;
-    }
-
-    stringstream ss(date);
-    char delimiter;
-    int day, month, year;
-
-    ss >> day >> delimiter >> month >> delimiter >> year;
-
-    if (year < 24 || year > 25)
-    {
-        return false;
-    }
-
-    if (month < 1 || month > 12)
-    {
-        return false;
-    }
-
-    if (day < 1)
-    {
-        return false;
-    }
-
-    //     
-    int daysInMonth = 0;
-    switch (month)
-    {
-    case 1:
-    case 3:
-    case 5:
-    case 7:
-    case 8:
-    case 10:
-    case 12:
-        daysInMonth = 31;
-        break;
-    case 4:
-    case 6:
-    case 9:
-    case 11:
-        daysInMonth = 30;
-        break;
-    case 2:
-        //         
-        daysInMonth = ((year % 4 == 0 && year % 100 != 0) || (year % 400 == 0)) ? 29 : 28;
-        break;
-    default:
-        return false;
-    }
-
-    if (day > daysInMonth)
-    {
-        return false;
-    }
+#include "Analytics.h"
+#include "BackgroundJournal.h"
+#include "BatchRunner.h"
+#include "Booking.h"
+#include "DataLoader.h"
+#include "IdRegistry.h"
+#include "InternPool.h"
+#include "Metrics.h"
+#include "Models.h"
+#include "OutputBench.h"
+#include "OutputBuffer.h"
+#include "PassengerRegistry.h"
+#include "Persistence.h"
+#include "RouteSearch.h"
+#include "ShipInventory.h"
+#include "Snapshot.h"
+#include "StressTest.h"
+#include "ThreadPool.h"
+#include "TicketTable.h"
+#include "Validation.h"
+#include "VoyageTable.h"
+#include "WriteAheadLog.h"
 
-    return true;
-}
+using namespace std;
 
 //    ,    
 class Cashier : public Person
@@ -169,37 +60,12 @@ public:
 
 string Cashier::organization = "FlexShip"; //    organization
 
-// ,   
-class Ship
-{
-public:
-    static int maxPassengerCapacity; //      
-
-    static void setMaxPassengerCapacity(int capacity)
-    {
-        maxPassengerCapacity = capacity;
-    }
-};
-
-//    maxPassengerCapacity
-int Ship::maxPassengerCapacity = 10;
+VoyageTable voyageTable;      //    
+ShipInventory shipInventory; //     
+TicketTable ticketTable;     //    
 
-class ShipInfo
-{
-public:
-    string departurePort;
-    string destinationPort;
-    string date;
-
-    ShipInfo() : departurePort(""), destinationPort(""), date("") {}
-
-    ShipInfo(const string &depart, const string &dest, const string &d) : departurePort(depart), destinationPort(dest), date(d) {}
-};
-
-map<string, ShipInfo> shipInfoMap;
-
-//    
-void addPassenger(vector<Passenger> &passengers, set<int> &usedIds)
+//    ;   
+const Passenger *addPassenger(BookingState &state)
 {
     string name, address, phoneNumber;
     int id;
@@ -212,233 +78,232 @@ void addPassenger(vector<Passenger> &passengers, set<int> &usedIds)
     getline(cin, address);
 
     //   
-    do
+    while (true)
     {
         cout << "Enter phone number (format: +380xxxxxxxxx): ";
         getline(cin, phoneNumber);
         if (!isValidPhoneNumber(phoneNumber))
         {
             cout << "Invalid phone number format. Please enter a valid phone number in the format +380xxxxxxxxx." << endl;
+            continue;
         }
-    } while (!isValidPhoneNumber(phoneNumber));
+        //     
+        if (state.passengers.findByPhone(phoneNumber) != nullptr)
+        {
+            cout << describeBookingStatus(BookingStatus::DuplicatePhoneNumber) << endl;
+            continue;
+        }
+        break;
+    }
 
-    //     ,        0
-    do
+    //     ,        0;
+    // 0 -    ID
+    while (true)
     {
-        cout << "Enter passenger ID (must be greater than or equal to 1): ";
+        int suggested = state.usedIds.nextId(state.idAllocation);
+        cout << "Enter passenger ID (must be greater than or equal to 1, 0 - next free ID " << suggested << "): ";
         cin >> id;
-        if (cin.fail() || usedIds.count(id) || id < 1)
+        if (!cin.fail() && id == 0)
         {
-            cout << "Invalid input for passenger ID. Please choose a different ID greater than or equal to 1." << endl;
-            cin.clear();
-            cin.ignore();
+            id = suggested;
         }
-
-    } while (cin.fail() || usedIds.count(id) || id < 1);
+        if (!cin.fail() && checkPassengerId(state, id) == BookingStatus::Ok)
+        {
+            break;
+        }
+        cout << "Invalid input for passenger ID. Please choose a different ID greater than or equal to 1." << endl;
+        cin.clear();
+        cin.ignore();
+    }
 
     cout << endl;
 
-    //         
-    Passenger passenger(name, address, phoneNumber, id);
-    passengers.push_back(passenger);
-
-    //  ID     ID
-    usedIds.insert(id);
+    //         
+    const Passenger *created = nullptr;
+    BookingStatus status = createPassenger(state, name, address, phoneNumber, id, &created);
+    if (status != BookingStatus::Ok)
+    {
+        cout << describeBookingStatus(status) << endl
+             << endl;
+        return nullptr;
+    }
 
     cout << "Passenger added successfully." << endl
          << endl;
+    return created;
 }
 
-int countPassengersOnShip(const vector<Passenger> &passengers, const string &shipName);
-
-//      
-void addTicket(vector<Passenger> &passengers, const string &shipName, set<int> &usedTicketIds)
+//      ;
+//  ,   ,  nullptr
+const Passenger *addTicket(BookingState &state, const string &shipName)
 {
-    //       
-    int passengerId, ticketId;
-    double price;
-    int cabinClass;
-
-    int maxPassengerCapacity = Ship::maxPassengerCapacity;
+    TicketRequest request;
+    request.shipName = shipName;
 
     //     
     do
     {
         cout << "Enter passenger ID: ";
-        if (!(cin >> passengerId) || passengerId <= 0)
+        if (!(cin >> request.passengerId) || request.passengerId <= 0)
         {
             cout << "Invalid input for passenger ID. Please choose a different ID." << endl;
             cin.clear();
             cin.ignore(numeric_limits<streamsize>::max(), '\n');
         }
-    } while (passengerId < 1);
+    } while (request.passengerId < 1);
 
-    //        
-    int economyClassCount = 0;
-    int businessClassCount = 0;
-    int firstClassCount = 0;
+    //        
+    BookingStatus status = checkPassengerCanBook(state, request.passengerId);
+    if (status != BookingStatus::Ok)
+    {
+        cout << describeBookingStatus(status) << endl
+             << endl;
+        return nullptr;
+    }
 
-    //     
-    bool passengerFound = false;
-    for (Passenger &passenger : passengers)
+    //  ID  (0 -   ID)    
+    while (true)
     {
-        if (passenger.id == passengerId)
+        int suggested = state.usedTicketIds.nextId(state.idAllocation);
+        cout << "Enter ticket ID (must be greater than or equal to 1, 0 - next free ID " << suggested << "): ";
+        cin >> request.ticketId;
+        if (!cin.fail() && request.ticketId == 0)
         {
-            passengerFound = true;
-            if (!passenger.tickets.empty())
-            { // ,      
-                cout << "Passenger already has a ticket. Cannot add another ticket." << endl;
-                return;
-            }
+            request.ticketId = suggested;
+        }
 
-            int passengersOnShip = countPassengersOnShip(passengers, shipName);
+        if (!cin.fail() && checkTicketId(state, request.ticketId) == BookingStatus::Ok)
+        {
+            break;
+        }
+        cout << "Invalid input for ticket ID. Please choose a different ID greater than or equal to 1." << endl;
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    }
 
-            //       
-            if (passengersOnShip >= maxPassengerCapacity)
-            {
-                cout << "Cannot add a ticket. The ship is full." << endl;
-                return;
-            }
+    //  ,     
+    const vector<uint32_t> &schedule = findShipVoyages(state, shipName);
+    if (!schedule.empty())
+    {
+        cout << "Voyages of ship " << shipName << ":" << endl;
+        for (uint32_t voyageId : schedule)
+        {
+            const Voyage &voyage = state.voyages.voyage(voyageId);
+            string date;
+            formatDate(date, voyage.date);
+            cout << date << " " << internPool().view(voyage.departurePort) << " -> " << internPool().view(voyage.destinationPort)
+                 << ": " << state.inventory.passengersOnVoyage(voyageId) << "/" << state.inventory.capacity(voyageId)
+                 << " passengers" << endl;
+        }
+    }
 
-            //  ID     
-            do
-            {
-                cout << "Enter ticket ID (must be greater than or equal to 1): ";
-                cin >> ticketId;
+    //  :        
+    cin.ignore();
+    uint32_t voyageId = VoyageTable::npos;
+    while (true)
+    {
+        cout << "Enter date (dd/mm/yy): ";
+        getline(cin, request.date);
+        Date date;
+        if (parseStoredDate(request.date, date))
+        {
+            voyageId = state.voyages.find(internPool().find(shipName), packDate(date));
+        }
+        if (voyageId != VoyageTable::npos || isValidDate(request.date))
+        {
+            break;
+        }
+        YearWindow years = ticketYearWindow();
+        cout << "Invalid date. Please enter date for " << years.first << "-" << years.last << " years" << endl;
+    }
+    if (voyageId != VoyageTable::npos && state.inventory.isVoyageFull(voyageId))
+    {
+        cout << describeBookingStatus(BookingStatus::ShipFull) << endl
+             << endl;
+        return nullptr;
+    }
 
-                if (cin.fail() || usedTicketIds.count(ticketId) || ticketId < 1)
-                {
-                    cout << "Invalid input for ticket ID. Please choose a different ID greater than or equal to 1." << endl;
-                    cin.clear();
-                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
-                }
-            } while (cin.fail() || usedTicketIds.count(ticketId) || ticketId < 1);
+    //      
+    if (voyageId == VoyageTable::npos)
+    {
+        cout << "Enter departure port: ";
+        getline(cin, request.departurePort);
 
-            //    ,    
-            string departurePort, destinationPort, date;
+        do
+        {
+            cout << "Enter destination port: ";
+            getline(cin, request.destinationPort);
 
-            if (shipInfoMap.find(shipName) != shipInfoMap.end())
+            if (request.destinationPort == request.departurePort)
             {
-                departurePort = shipInfoMap[shipName].departurePort;
-                destinationPort = shipInfoMap[shipName].destinationPort;
-                date = shipInfoMap[shipName].date;
+                cout << "Destination port cannot be the same as departure port. Please enter a different destination port." << endl;
             }
-            else
-            {
-                cout << "Enter departure port: ";
-                cin.ignore();
-                getline(cin, departurePort);
-
-                do
-                {
-                    cout << "Enter destination port: ";
-                    getline(cin, destinationPort);
-
-                    if (destinationPort == departurePort)
-                    {
-                        cout << "Destination port cannot be the same as departure port. Please enter a different destination port." << endl;
-                    }
-                } while (destinationPort == departurePort);
-
-                //   
-                do
-                {
-                    cout << "Enter date (dd/mm/yy): ";
-                    getline(cin, date);
-                    if (!isValidDate(date))
-                    {
-                        cout << "Invalid date. Please enter date for 24-25 years" << endl;
-                    }
-                } while (!isValidDate(date));
-
-                shipInfoMap[shipName] = ShipInfo(departurePort, destinationPort, date);
-            }
-            //      
-            while (true)
+        } while (request.destinationPort == request.departurePort);
+    }
+    //      
+    while (true)
+    {
+        cout << "Enter cabin class (1 - Economy (51 - 249$), 2 - Business (251 - 499$), 3 - First (501 - 999$)): ";
+        if (!(cin >> request.cabinClass) || (request.cabinClass < 1 || request.cabinClass > 3))
+        {
+            cout << "Invalid input. Please enter a valid cabin class (1, 2, or 3)." << endl;
+            cin.clear();
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        }
+        else
+        {
+            cout << "Enter price: $";
+            if (!(cin >> request.price))
             {
-                cout << "Enter cabin class (1 - Economy (51 - 249$), 2 - Business (251 - 499$), 3 - First (501 - 999$)): ";
-                if (!(cin >> cabinClass) || (cabinClass < 1 || cabinClass > 3))
-                {
-                    cout << "Invalid input. Please enter a valid cabin class (1, 2, or 3)." << endl;
-                    cin.clear();
-                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
-                }
-                else
-                {
-                    cout << "Enter price: $";
-                    if (!(cin >> price))
-                    {
-                        cout << "Invalid input. Please enter a valid price." << endl;
-                        cin.clear();
-                        cin.ignore(numeric_limits<streamsize>::max(), '\n');
-                    }
-                    else
-                    { //     
-                        if ((cabinClass == 1 && (price <= 50 || price >= 250)) ||
-                            (cabinClass == 2 && (price <= 250 || price >= 500)) ||
-                            (cabinClass == 3 && (price <= 500 || price >= 1000)))
-                        {
-                            cout << "Invalid price for the selected cabin class. Please enter a valid price." << endl;
-                        }
-                        else
-                        {
-                            break;
-                        }
-                    }
-                }
+                cout << "Invalid input. Please enter a valid price." << endl;
+                cin.clear();
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
             }
-            // ˳        
-            for (const Passenger &pass : passengers)
+            else if (!isValidPrice(request.cabinClass, request.price)) //     
             {
-                for (const Ticket &ticket : pass.tickets)
-                {
-                    if (ticket.shipName == shipName)
-                    {
-                        if (ticket.cabinClass == 1)
-                        {
-                            economyClassCount++;
-                        }
-                        else if (ticket.cabinClass == 2)
-                        {
-                            businessClassCount++;
-                        }
-                        else if (ticket.cabinClass == 3)
-                        {
-                            firstClassCount++;
-                        }
-                    }
-                }
+                cout << "Invalid price for the selected cabin class. Please enter a valid price." << endl;
             }
-            //        
-            if ((cabinClass == 1 && economyClassCount >= 6) ||
-                (cabinClass == 2 && businessClassCount >= 2) ||
-                (cabinClass == 3 && firstClassCount >= 2))
+            else
             {
-                cout << endl;
-                cout << "Cannot add a ticket. The selected cabin class is full." << endl;
-                cout << endl;
-                return;
+                break;
             }
-            //     
-            usedTicketIds.insert(ticketId);
-            Ticket ticket(ticketId, departurePort, destinationPort, date, cabinClass, price, shipName);
-            passenger.tickets.push_back(ticket);
-            cout << endl;
-            cout << "Ticket added successfully." << endl
-                 << endl;
+        }
+    }
+
+    //  : 0 -     
+    while (true)
+    {
+        int cabin;
+        cout << "Enter cabin number (0 - first free cabin): ";
+        if (cin >> cabin && cabin >= 0)
+        {
+            request.cabin = static_cast<uint32_t>(cabin);
             break;
         }
+        cout << "Invalid input. Please enter a cabin number or 0." << endl;
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
     }
-    // ,    
-    if (!passengerFound)
+
+    //          
+    const Passenger *booked = nullptr;
+    status = issueTicket(state, request, &booked);
+    if (status != BookingStatus::Ok)
     {
-        cout << "Passenger not found." << endl
-             << endl;
+        cout << endl;
+        cout << describeBookingStatus(status) << endl;
+        cout << endl;
+        return nullptr;
     }
+    cout << endl;
+    cout << "Ticket added successfully. Cabin number: " << state.tickets.cabin(booked->tickets.back()) << endl
+         << endl;
+    return booked;
 }
 
-//      
-void displayPassengers(const vector<Passenger> &passengers)
+//         pageSize
+//  (0 -  )
+void displayPassengers(const PassengerRegistry &passengers, size_t pageSize)
 {
     if (passengers.empty())
     {
@@ -447,10 +312,9 @@ void displayPassengers(const vector<Passenger> &passengers)
     }
 
     cout << "Passenger list:" << endl;
-    for (const auto &passenger : passengers)
-    {
-        passenger.displayInfo();
-    }
+    OutputBuffer out(stdout);
+    writePaged(out, passengers.size(), pageSize, cin, [&passengers](string &text, size_t i)
+               { formatPassengerInfo(text, passengers[i]); });
 }
 //      
 void displayCashierInfo(const Cashier &cashier)
@@ -458,7 +322,8 @@ void displayCashierInfo(const Cashier &cashier)
     cashier.displayInfo();
 }
 
-void displayTickets(const vector<Passenger> &passengers)
+//     pageSize  (0 -  )
+void displayTickets(const PassengerRegistry &passengers, size_t pageSize)
 {
     if (passengers.empty())
     {
@@ -467,274 +332,358 @@ void displayTickets(const vector<Passenger> &passengers)
     }
 
     cout << "Ticket list:" << endl;
-    for (const auto &passenger : passengers)
+    OutputBuffer out(stdout);
+    writePaged(out, passengers.size(), pageSize, cin, [&passengers](string &text, size_t i)
+               { formatPassengerTickets(text, passengers[i], ticketTable); });
+}
+
+//  ,     ,  ,  
+//     .     
+// ,      .
+void reportQueued(const BackgroundJournal &journal, uint64_t sequence)
+{
+    if (sequence == 0 || journal.failed())
     {
-        cout << "Passenger: " << passenger.name << endl;
-        if (passenger.tickets.empty())
-        {
-            cout << "No tickets available." << endl;
-        }
-        else
-        {
-            for (const auto &ticket : passenger.tickets)
-            {
-                cout << "Ticket ID: " << ticket.id << endl;
-                cout << "Ship Name: " << ticket.shipName << endl;
-                cout << "Departure Port: " << ticket.departurePort << endl;
-                cout << "Destination Port: " << ticket.destinationPort << endl;
-                cout << "Date: " << ticket.date << endl;
-                cout << "Cabin Class: " << ticket.cabinClass << endl;
-                cout << "Price: $" << ticket.price << endl;
-                cout << endl;
-            }
-        }
+        cout << "Error writing to the data files (saved up to record #" << journal.durable() << ")." << endl;
+        return;
     }
+    cout << "Record #" << sequence << " queued for saving (saved up to record #" << journal.durable() << ")."
+         << endl;
 }
 
-int countPassengersOnShip(const vector<Passenger> &passengers, const string &shipName)
+//  ,       
+//    
+void maintainJournal(BackgroundJournal &journal, const PassengerRegistry &passengers)
 {
-    int count = 0;
-    for (const Passenger &passenger : passengers)
+    // ϳ      ,   ' 
+    //  ,    
+    bool failed = journal.failed();
+    if (!journal.compactIfNeeded(passengers, ticketTable, voyageTable))
     {
-        for (const Ticket &ticket : passenger.tickets)
-        {
-            if (ticket.shipName == shipName)
-            {
-                count++;
-            }
-        }
+        cout << "Error compacting the data files." << endl;
     }
-    if (count == 0)
+    else if (failed)
     {
-        cout << "No tickets have been created for the ship " << shipName << "." << endl;
+        cout << "The data files were rewritten from memory." << endl;
     }
-    return count;
 }
 
-vector<string> getUniqueShipNames(const vector<Passenger> &passengers)
+//    :
+// --batch FILE|- (   ),
+// --fsync record|group|interval, --fsync-group N, --fsync-interval MS,
+// --snapshot FILE|none, --text-export on|off,
+// --years FIRST-LAST (   ,   ),
+// --topk exact|sketch, --topk-capacity N ( ),
+// --threads N (   , 0 -   ),
+// --stress N (   N   ),
+// --page-size N (     , 0 -  ),
+// --bench-output N (   N   ),
+// --metrics-file FILE, --metrics-interval SECONDS (    Prometheus),
+// --ids monotonic|lowest ( ID       ID),
+// --wal FILE|none (      )
+bool parseCommandLine(int argc, char *argv[], JournalOptions &options, TopKOptions &topOptions, string &batchFile,
+                      int &stressCashiers, size_t &pageSize, size_t &benchRecords, string &metricsFile,
+                      int &metricsInterval, IdAllocation &idAllocation)
 {
-    vector<string> uniqueShipNames;
-    bool hasTickets = false; // ,  ,     
-    for (const Passenger &passenger : passengers)
+    for (int i = 1; i < argc; i++)
     {
-        for (const Ticket &ticket : passenger.tickets)
+        string arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            cout << "Missing value for option " << arg << "." << endl;
+            return false;
+        }
+        string value = argv[++i];
+        if (arg == "--batch")
+        {
+            batchFile = value;
+        }
+        else if (arg == "--fsync")
         {
-            hasTickets = true;
-            if (find(uniqueShipNames.begin(), uniqueShipNames.end(), ticket.shipName) == uniqueShipNames.end())
+            if (value == "record")
+            {
+                options.policy = FsyncPolicy::PerRecord;
+            }
+            else if (value == "group")
+            {
+                options.policy = FsyncPolicy::GroupCommit;
+            }
+            else if (value == "interval")
+            {
+                options.policy = FsyncPolicy::Interval;
+            }
+            else
             {
-                uniqueShipNames.push_back(ticket.shipName);
+                cout << "Unknown fsync policy: " << value << "." << endl;
+                return false;
             }
         }
-    }
-    return uniqueShipNames;
-}
-
-vector<int> getMostPopularCabinClasses(const vector<Passenger> &passengers)
-{
-    map<int, int> cabinClassCounts;
-    int maxCount = 0;
-    bool hasTickets = false;
-    for (const Passenger &passenger : passengers)
-    {
-        for (const Ticket &ticket : passenger.tickets)
+        else if (arg == "--snapshot")
         {
-            hasTickets = true;
-            cabinClassCounts[ticket.cabinClass]++;
-            maxCount = max(maxCount, cabinClassCounts[ticket.cabinClass]);
+            options.snapshotFilename = value == "none" ? "" : value;
         }
-    }
-    vector<int> mostPopularCabinClasses;
-    for (const auto &entry : cabinClassCounts)
-    {
-        if (entry.second == maxCount)
+        else if (arg == "--wal")
         {
-            mostPopularCabinClasses.push_back(entry.first);
+            options.walFilename = value == "none" ? "" : value;
         }
-    }
-    if (!hasTickets)
-    {
-        cout << "No tickets found." << endl;
-    }
-    return mostPopularCabinClasses;
-}
-
-double calculateTotalRevenue(const vector<Passenger> &passengers)
-{
-    double totalRevenue = 0.0;
-    bool hasTickets = false;
-    for (const Passenger &passenger : passengers)
-    {
-        for (const Ticket &ticket : passenger.tickets)
+        else if (arg == "--text-export")
         {
-            hasTickets = true;
-            totalRevenue += ticket.price;
+            if (value != "on" && value != "off")
+            {
+                cout << "Invalid value for --text-export (expected on or off)." << endl;
+                return false;
+            }
+            options.textExport = value == "on";
         }
-    }
-    if (!hasTickets)
-    {
-        cout << "No tickets found." << endl;
-    }
-    return totalRevenue;
-}
-
-int countPassengers(const vector<Passenger> &passengers)
-{
-    int count = 0;
-    for (const Passenger &passenger : passengers)
-    {
-        count++;
-    }
-    return count;
-}
-
-vector<string> getMostPopularDestinationPorts(const vector<Passenger> &passengers)
-{
-    map<string, int> destinationPortCounts;
-    bool hasTickets = false;
-    for (const Passenger &passenger : passengers)
-    {
-        for (const Ticket &ticket : passenger.tickets)
+        else if (arg == "--years")
         {
-            hasTickets = true;
-            destinationPortCounts[ticket.destinationPort]++;
+            YearWindow years;
+            char separator;
+            istringstream input(value);
+            if (!(input >> years.first >> separator >> years.last) || separator != '-' ||
+                years.first < 0 || years.last > 99 || years.first > years.last)
+            {
+                cout << "Invalid value for --years (expected FIRST-LAST, e.g. 24-25)." << endl;
+                return false;
+            }
+            setTicketYearWindow(years);
         }
-    }
-    vector<string> mostPopularDestinationPorts;
-    int maxCount = 0;
-    for (const auto &entry : destinationPortCounts)
-    {
-        if (entry.second > maxCount)
+        else if (arg == "--topk")
         {
-            mostPopularDestinationPorts.clear();
-            mostPopularDestinationPorts.push_back(entry.first);
-            maxCount = entry.second;
+            if (value != "exact" && value != "sketch")
+            {
+                cout << "Invalid value for --topk (expected exact or sketch)." << endl;
+                return false;
+            }
+            topOptions.mode = value == "exact" ? TopKMode::Exact : TopKMode::Sketch;
         }
-        else if (entry.second == maxCount)
+        else if (arg == "--topk-capacity")
         {
-            mostPopularDestinationPorts.push_back(entry.first);
+            topOptions.capacity = static_cast<size_t>(max(1, atoi(value.c_str())));
+        }
+        else if (arg == "--stress")
+        {
+            stressCashiers = max(1, atoi(value.c_str()));
+        }
+        else if (arg == "--page-size")
+        {
+            pageSize = static_cast<size_t>(max(0, atoi(value.c_str())));
+        }
+        else if (arg == "--bench-output")
+        {
+            benchRecords = static_cast<size_t>(max(1, atoi(value.c_str())));
+        }
+        else if (arg == "--metrics-file")
+        {
+            metricsFile = value;
+        }
+        else if (arg == "--metrics-interval")
+        {
+            metricsInterval = max(1, atoi(value.c_str()));
+        }
+        else if (arg == "--ids")
+        {
+            if (value != "monotonic" && value != "lowest")
+            {
+                cout << "Invalid value for --ids (expected monotonic or lowest)." << endl;
+                return false;
+            }
+            idAllocation = value == "monotonic" ? IdAllocation::Monotonic : IdAllocation::LowestFree;
+        }
+        else if (arg == "--threads")
+        {
+            setThreadPoolSize(static_cast<size_t>(max(0, atoi(value.c_str()))));
+        }
+        else if (arg == "--fsync-group")
+        {
+            options.groupSize = max(1, atoi(value.c_str()));
+        }
+        else if (arg == "--fsync-interval")
+        {
+            options.intervalMs = max(0, atoi(value.c_str()));
+        }
+        else
+        {
+            cout << "Unknown option: " << arg << "." << endl;
+            return false;
         }
     }
-    if (!hasTickets)
-    {
-        cout << "No tickets found." << endl;
-    }
-    return mostPopularDestinationPorts;
+    return true;
 }
 
-void saveReservationsToFile(const vector<Passenger> &passengers, const string &filename)
+//     ;    ( )
+bool readDateRange(uint32_t &from, uint32_t &to)
 {
-    ofstream file(filename);
-
-    if (!file)
+    string text;
+    Date date;
+    cout << "Enter start date (dd/mm/yy): ";
+    cin.ignore();
+    getline(cin, text);
+    if (!parseStoredDate(text, date))
     {
-        cout << "Error opening the file." << endl;
-        return;
+        cout << "Invalid date." << endl;
+        return false;
     }
-
-    for (const Passenger &passenger : passengers)
+    from = packDate(date);
+    cout << "Enter end date (dd/mm/yy): ";
+    getline(cin, text);
+    if (!parseStoredDate(text, date))
     {
-        if (!passenger.tickets.empty())
-        {
-            file << "Reservations for Passenger: " << passenger.name << " (ID: " << passenger.id << ")" << endl;
-            for (const Ticket &ticket : passenger.tickets)
-            {
-                file << "Ticket ID: " << ticket.id << endl;
-                file << "Ship Name: " << ticket.shipName << endl;
-                file << "Departure Port: " << ticket.departurePort << endl;
-                file << "Destination Port: " << ticket.destinationPort << endl;
-                file << "Date: " << ticket.date << endl;
-                file << "Cabin Class: " << ticket.cabinClass << endl;
-                file << "Price: $" << ticket.price << endl;
-                file << endl;
-            }
-        }
+        cout << "Invalid date." << endl;
+        return false;
     }
-
-    file.close();
+    to = packDate(date);
+    return true;
 }
 
-void saveDataToFile(const vector<Passenger> &passengers, const string &filename)
+// ³ :   (    ),
+// ,      ,    
+// ,       (  -  recovered)
+bool loadSavedState(const JournalOptions &options, const string &passengerFilename, const string &reservationFilename,
+                    PassengerRegistry &passengers, IdRegistry &usedIds, IdRegistry &usedTicketIds, LoadStats &stats,
+                    size_t &recovered)
 {
-    ofstream file(filename);
+    recovered = 0;
+    size_t passengerStart = 0;
+    size_t reservationStart = 0;
+    bool snapshotLoaded = false;
 
-    if (!file)
-    {
-        cout << "Error opening the file." << endl;
-        return;
-    }
+    //     ,      
+    bool layoutsLoaded = !options.layoutFilename.empty() && loadCabinLayouts(options.layoutFilename, shipInventory, stats);
 
-    for (const Passenger &passenger : passengers)
+    SnapshotView snapshot;
+    if (!options.snapshotFilename.empty() && snapshot.open(options.snapshotFilename))
     {
-        file << "Passenger" << endl;
-        file << "Name: " << passenger.name << endl;
-        file << "Address: " << passenger.address << endl;
-        file << "Phone number: " << passenger.phoneNumber << endl;
-        file << "ID: " << passenger.id << endl;
-        file << endl;
+        const SnapshotTextState &text = snapshot.header().text;
+        uint64_t passengerFingerprint, reservationFingerprint;
+        if (fingerprintTextFile(passengerFilename, text.passengerFileSize, passengerFingerprint) &&
+            fingerprintTextFile(reservationFilename, text.reservationFileSize, reservationFingerprint) &&
+            passengerFingerprint == text.passengerFingerprint && reservationFingerprint == text.reservationFingerprint)
+        {
+            restoreFromSnapshot(snapshot, passengers, ticketTable, usedIds, usedTicketIds, voyageTable, shipInventory, stats);
+            passengerStart = static_cast<size_t>(text.passengerFileSize);
+            reservationStart = static_cast<size_t>(text.reservationFileSize);
+            snapshotLoaded = true;
+        }
+        else
+        {
+            //      -    
+            cout << "Snapshot does not match the data files, loading text files instead." << endl;
+        }
+        snapshot.close();
     }
 
-    file.close();
-    cout << "Data saved to file successfully." << endl;
+    bool passengersLoaded = loadPassengersFromFile(passengerFilename, passengers, usedIds, stats, passengerStart);
+    bool reservationsLoaded = loadReservationsFromFile(reservationFilename, passengers, ticketTable, usedTicketIds, voyageTable,
+                                                       shipInventory, stats, reservationStart);
+    bool walLoaded = !options.walFilename.empty() &&
+                     replayWriteAheadLog(options.walFilename, passengers, ticketTable, usedIds, usedTicketIds, voyageTable,
+                                         shipInventory, stats, recovered);
+    return layoutsLoaded || snapshotLoaded || passengersLoaded || reservationsLoaded || walLoaded;
 }
 
-void displayDataFromFile(const string &passengerFilename)
+int main(int argc, char *argv[])
 {
-    ifstream file(passengerFilename);
-
-    if (!file)
+    JournalOptions journalOptions;
+    journalOptions.snapshotFilename = "projectkr.snapshot";
+    journalOptions.layoutFilename = "ship_layouts.txt";
+    journalOptions.walFilename = "projectkr.wal";
+    string batchFile;
+    TopKOptions topOptions;
+    int stressCashiers = 0;
+    size_t pageSize = 20;
+    size_t benchRecords = 0;
+    string metricsFile;
+    int metricsInterval = 10;
+    IdAllocation idAllocation = IdAllocation::Monotonic;
+    if (!parseCommandLine(argc, argv, journalOptions, topOptions, batchFile, stressCashiers, pageSize, benchRecords,
+                          metricsFile, metricsInterval, idAllocation))
     {
-        cout << "Error opening the file for displaying data." << endl;
-        return;
+        return 1;
     }
-
-    string line;
-    bool isEmpty = true; // ,  ,   
-
-    while (getline(file, line))
+    //   : ,   SIGUSR1    
+    MetricsExporter metricsExporter;
+    if (!metricsFile.empty() && !metricsExporter.start(metricsFile, metricsInterval))
     {
-        cout << line << endl;
-        isEmpty = false; //   ,      
+        cerr << "Metrics are not available: the program was built without PROJECTKR_METRICS." << endl;
     }
-
-    file.close();
-
-    if (isEmpty)
+    if (stressCashiers > 0)
     {
-        cout << "The file is empty." << endl;
+        //    ':       
+        return runBookingStress(static_cast<size_t>(stressCashiers), 20000, cout) ? 0 : 1;
     }
-    else
+    if (benchRecords > 0)
     {
-        cout << "Data displayed from file successfully." << endl;
+        return runOutputBenchmark(benchRecords, cout) ? 0 : 1;
     }
-}
-
-void clearDataFiles(const string &passengerFilename, const string &reservationFilename)
-{
-    ofstream passengerFile(passengerFilename, ios::trunc);     // ³    
-    ofstream reservationFile(reservationFilename, ios::trunc); // ³    
+    ticketTable.setPopularityOptions(topOptions);
+    bool batchMode = !batchFile.empty();
+    //        
+    ostream &status = batchMode ? cerr : cout;
+
+    PassengerRegistry passengers;
+    IdRegistry usedIds;       //      
+    IdRegistry usedTicketIds; //      ID 
+    BookingState state{passengers, ticketTable, usedIds, usedTicketIds, voyageTable, shipInventory, idAllocation};
+    Cashier cashier("FlexShip", "Jane", "555-1234", 500.0);
+    int choice;
 
-    if (!passengerFile || !reservationFile)
+    // ³   ,     
+    LoadStats loadStats;
+    size_t recovered = 0;
+    if (loadSavedState(journalOptions, "passenger_data.txt", "reservations.txt", passengers, usedIds, usedTicketIds, loadStats,
+                       recovered))
     {
-        cout << "Error opening the files for clearing data." << endl;
-        return;
+        status << "Loaded " << loadStats.passengers << " passengers and " << loadStats.tickets << " tickets from files." << endl;
+        if (loadStats.skippedRecords > 0)
+        {
+            status << "Skipped " << loadStats.skippedRecords << " incomplete or invalid records." << endl;
+        }
     }
 
-    //   
-    passengerFile.close();
-    reservationFile.close();
-    cout << "Data files cleared successfully." << endl;
-}
+    //         
+    Journal journal("passenger_data.txt", "reservations.txt", journalOptions);
+    if (!journal.open())
+    {
+        status << "Error opening the data files for writing." << endl;
+    }
+    else if (recovered > 0)
+    {
+        // ³       ,  
+        status << "Recovered " << recovered << " records from the write-ahead log." << endl;
+        if (!journal.compact(passengers, ticketTable, voyageTable))
+        {
+            status << "Error saving data files." << endl;
+        }
+    }
 
-int main()
-{
-    vector<Passenger> passengers;
-    set<int> usedIds;       //      
-    set<int> usedTicketIds; //      ID 
-    Cashier cashier("FlexShip", "Jane", "555-1234", 500.0);
-    int choice;
+    if (batchMode)
+    {
+        BatchStats batchStats;
+        if (!runBatchFile(batchFile, state, &journal, cout, cerr, batchStats))
+        {
+            cerr << "Error opening the batch file " << batchFile << "." << endl;
+            return 1;
+        }
+        cout.flush();
+        cerr << "Batch finished: " << batchStats.commands << " commands, " << batchStats.succeeded << " succeeded, "
+             << batchStats.failed << " failed in " << batchStats.seconds << " s";
+        if (batchStats.seconds > 0)
+        {
+            cerr << " (" << static_cast<long long>(batchStats.commands / batchStats.seconds) << " commands/s)";
+        }
+        cerr << "." << endl;
 
-    clearDataFiles("passenger_data.txt", "reservations.txt");
+        if (!journal.compact(passengers, ticketTable, voyageTable))
+        {
+            cerr << "Error saving data files." << endl;
+            return 1;
+        }
+        return batchStats.failed == 0 ? 0 : 2;
+    }
 
+    //     :     
+    BackgroundJournal background(journal);
     while (true)
     {
         cout << "Menu:" << endl;
@@ -763,6 +712,7 @@ int main()
                 cout << "Creation Menu:" << endl;
                 cout << "1. Create passenger" << endl;
                 cout << "2. Create ticket" << endl;
+                cout << "3. Configure ship cabins" << endl;
                 cout << "0. Back to main menu" << endl;
                 cout << "Enter your choice: ";
                 cin >> creationChoice;
@@ -774,8 +724,12 @@ int main()
                 case 1: // Create passenger
                 {
                     cout << endl;
-                    addPassenger(passengers, usedIds); //  usedIds   
-                    saveDataToFile(passengers, "passenger_data.txt");
+                    const Passenger *added = addPassenger(state);
+                    if (added != nullptr)
+                    {
+                        reportQueued(background, background.submitPassenger(*added));
+                        maintainJournal(background, passengers);
+                    }
                     break;
                 }
                 case 2: // Create ticket
@@ -791,8 +745,53 @@ int main()
                     cout << "Enter ship name: ";
                     cin.ignore();
                     getline(cin, shipName);
-                    addTicket(passengers, shipName, usedTicketIds); //  usedTicketIds   
-                    saveReservationsToFile(passengers, "reservations.txt");
+                    const Passenger *booked = addTicket(state, shipName);
+                    if (booked != nullptr)
+                    {
+                        reportQueued(background, background.submitReservation(*booked, ticketTable,
+                                                                              booked->tickets.back()));
+                        maintainJournal(background, passengers);
+                    }
+                    break;
+                }
+                case 3: // Configure ship cabins
+                {
+                    cout << endl;
+                    string shipName;
+                    cout << "Enter ship name: ";
+                    cin.ignore();
+                    getline(cin, shipName);
+                    CabinLayout layout = {};
+                    const char *classNames[cabinClassCount] = {"economy", "business", "first"};
+                    bool valid = true;
+                    for (int i = 0; i < cabinClassCount && valid; i++)
+                    {
+                        int cabins;
+                        cout << "Enter number of " << classNames[i] << " cabins: ";
+                        valid = cin >> cabins && cabins >= 0;
+                        layout.cabins[i] = valid ? static_cast<uint32_t>(cabins) : 0;
+                    }
+                    cout << endl;
+                    if (!valid || !layout.isValid())
+                    {
+                        cout << "Invalid cabin layout. A ship can have up to " << maxCabinsPerClass << " cabins." << endl;
+                        cin.clear();
+                        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                        break;
+                    }
+                    if (!configureShipLayout(state, internPool().intern(shipName), layout))
+                    {
+                        cout << "The ship already has tickets; its cabin layout cannot be changed." << endl;
+                        break;
+                    }
+                    if (!journal.saveCabinLayouts(shipInventory))
+                    {
+                        cout << "Error writing cabin layouts to the file. The layout is in use, but it is not saved to disk." << endl;
+                    }
+                    else
+                    {
+                        cout << "Cabin layout saved." << endl;
+                    }
                     break;
                 }
                 default:
@@ -833,7 +832,8 @@ int main()
                     }
                     else
                     {
-                        displayPassengers(passengers);
+                        cin.ignore(); //    
+                        displayPassengers(passengers, pageSize);
                     }
                     break;
                 case 2:
@@ -849,7 +849,8 @@ int main()
                     }
                     else
                     {
-                        displayTickets(passengers);
+                        cin.ignore();
+                        displayTickets(passengers, pageSize);
                     }
                     break;
                 case 0:
@@ -879,6 +880,15 @@ int main()
                 cout << "4. Calculate total revenue" << endl;
                 cout << "5. Display most popular destination ports" << endl;
                 cout << "6. Total passengers" << endl;
+                cout << "7. Departures between dates" << endl;
+                cout << "8. Revenue between dates" << endl;
+                cout << "9. Top destination ports" << endl;
+                cout << "10. Top routes" << endl;
+                cout << "11. Revenue by ship" << endl;
+                cout << "12. Voyages and free cabins of ship" << endl;
+                cout << "13. Find sailings on route" << endl;
+                cout << "14. Find passenger by phone or name" << endl;
+                cout << "15. Show metrics" << endl;
                 cout << "0. Back to main menu" << endl;
                 cout << "Enter your choice: ";
                 int shipStatisticsChoice;
@@ -890,7 +900,7 @@ int main()
                     break;
                 case 1:
                 {
-                    vector<string> uniqueShipNames = getUniqueShipNames(passengers);
+                    vector<string_view> uniqueShipNames = getUniqueShipNames(ticketTable);
                     if (uniqueShipNames.empty())
                     {
                         cout << endl;
@@ -900,7 +910,7 @@ int main()
                     {
                         cout << endl;
                         cout << "Available ships:" << endl;
-                        for (const string &ship : uniqueShipNames)
+                        for (string_view ship : uniqueShipNames)
                         {
                             cout << ship << endl;
                         }
@@ -911,16 +921,15 @@ int main()
                         cin.ignore();
                         getline(cin, shipName);
 
-                        //       
-                        auto shipFound = find(uniqueShipNames.begin(), uniqueShipNames.end(), shipName);
-                        if (shipFound == uniqueShipNames.end())
+                        //  ,           
+                        if (findShipVoyages(state, shipName).empty())
                         {
                             cout << "Ship '" << shipName << "' not found." << endl
                                  << endl;
                         }
                         else
                         {
-                            int count = countPassengersOnShip(passengers, shipName);
+                            int count = countPassengersOnShip(voyageTable, shipInventory, shipName);
                             cout << endl;
                             cout << "Passengers on ship " << shipName << ": " << count << endl
                                  << endl;
@@ -930,7 +939,7 @@ int main()
                 }
                 case 2:
                 {
-                    vector<string> uniqueShipNames = getUniqueShipNames(passengers);
+                    vector<string_view> uniqueShipNames = getUniqueShipNames(ticketTable);
                     bool shipsExist = !uniqueShipNames.empty(); //   
 
                     if (!shipsExist)
@@ -943,7 +952,7 @@ int main()
                     {
                         cout << endl;
                         cout << "Unique ship names:" << endl;
-                        for (const string &shipName : uniqueShipNames)
+                        for (string_view shipName : uniqueShipNames)
                         {
                             cout << shipName << endl;
                         }
@@ -962,7 +971,7 @@ int main()
                     else
                     {
                         cout << endl;
-                        vector<int> mostPopularCabinClasses = getMostPopularCabinClasses(passengers);
+                        vector<int> mostPopularCabinClasses = getMostPopularCabinClasses(ticketTable);
 
                         cout << "Most popular cabin class(es):";
                         for (int cabinClass : mostPopularCabinClasses)
@@ -985,7 +994,7 @@ int main()
                     else
                     {
                         cout << endl;
-                        double totalRevenue = calculateTotalRevenue(passengers);
+                        double totalRevenue = calculateTotalRevenue(ticketTable);
                         cout << "Total revenue: $" << totalRevenue << endl
                              << endl;
                     }
@@ -1002,9 +1011,9 @@ int main()
                     else
                     {
                         cout << endl;
-                        vector<string> mostPopularDestinationPorts = getMostPopularDestinationPorts(passengers);
+                        vector<string_view> mostPopularDestinationPorts = getMostPopularDestinationPorts(ticketTable);
                         cout << "Most popular destination port(s): ";
-                        for (const string &port : mostPopularDestinationPorts)
+                        for (string_view port : mostPopularDestinationPorts)
                         {
                             cout << port << " ";
                         }
@@ -1021,6 +1030,215 @@ int main()
                          << endl;
                     break;
                 }
+                case 7:
+                {
+                    cout << endl;
+                    uint32_t from, to;
+                    if (!readDateRange(from, to))
+                    {
+                        break;
+                    }
+                    vector<uint32_t> departures = getDeparturesBetween(voyageTable, from, to);
+                    cout << endl;
+                    if (departures.empty())
+                    {
+                        cout << "No departures found." << endl
+                             << endl;
+                        break;
+                    }
+                    cout << "Departures:" << endl;
+                    for (uint32_t voyageId : departures)
+                    {
+                        const Voyage &voyage = voyageTable.voyage(voyageId);
+                        string date;
+                        formatDate(date, voyage.date);
+                        cout << date << " " << internPool().view(voyage.shipId) << ": " << internPool().view(voyage.departurePort)
+                             << " -> " << internPool().view(voyage.destinationPort) << endl;
+                    }
+                    cout << endl;
+                    break;
+                }
+                case 8:
+                {
+                    cout << endl;
+                    uint32_t from, to;
+                    if (!readDateRange(from, to))
+                    {
+                        break;
+                    }
+                    cout << endl;
+                    cout << "Revenue: $" << calculateRevenueBetween(ticketTable, from, to) << endl
+                         << endl;
+                    break;
+                }
+                case 9:
+                case 10:
+                {
+                    bool routes = shipStatisticsChoice == 10;
+                    int k;
+                    cout << endl;
+                    cout << "How many entries to show: ";
+                    if (!(cin >> k) || k < 1)
+                    {
+                        cout << "Invalid number." << endl
+                             << endl;
+                        cin.clear();
+                        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                        break;
+                    }
+                    cout << endl;
+                    cout << (routes ? "Top routes:" : "Top destination ports:") << endl;
+                    printTopK(cout, getTopDestinations(ticketTable, routes, static_cast<size_t>(k)), routes);
+                    cout << endl;
+                    break;
+                }
+                case 11:
+                {
+                    cout << endl;
+                    vector<ShipSummary> report = getShipReport(ticketTable);
+                    if (report.empty())
+                    {
+                        cout << "No tickets created yet." << endl
+                             << endl;
+                        break;
+                    }
+                    cout << "Revenue by ship:" << endl;
+                    for (const ShipSummary &ship : report)
+                    {
+                        cout << internPool().view(ship.shipId) << ": " << ship.tickets << " tickets, $" << ship.revenue << endl;
+                    }
+                    cout << endl;
+                    break;
+                }
+                case 12:
+                {
+                    cout << endl;
+                    string shipName;
+                    cout << "Enter ship name: ";
+                    cin.ignore();
+                    getline(cin, shipName);
+                    const vector<uint32_t> &schedule = findShipVoyages(state, shipName);
+                    cout << endl;
+                    if (schedule.empty())
+                    {
+                        cout << "No voyages found for the ship " << shipName << "." << endl
+                             << endl;
+                        break;
+                    }
+                    const char *classNames[cabinClassCount] = {"Economy", "Business", "First"};
+                    for (uint32_t voyageId : schedule)
+                    {
+                        const Voyage &voyage = voyageTable.voyage(voyageId);
+                        string date;
+                        formatDate(date, voyage.date);
+                        cout << date << " " << internPool().view(voyage.departurePort) << " -> "
+                             << internPool().view(voyage.destinationPort) << ": " << shipInventory.passengersOnVoyage(voyageId)
+                             << "/" << shipInventory.capacity(voyageId) << " passengers" << endl;
+                        CabinLayout layout = shipInventory.layout(voyageId);
+                        for (int cabinClass = 1; cabinClass <= cabinClassCount; cabinClass++)
+                        {
+                            cout << "  " << classNames[cabinClass - 1] << ": " << shipInventory.freeCabins(voyageId, cabinClass)
+                                 << " of " << layout.cabins[cabinClass - 1] << " cabins free" << endl;
+                        }
+                    }
+                    cout << endl;
+                    break;
+                }
+                case 13:
+                {
+                    cout << endl;
+                    string departurePort, destinationPort, text;
+                    cout << "Enter departure port: ";
+                    cin.ignore();
+                    getline(cin, departurePort);
+                    cout << "Enter destination port: ";
+                    getline(cin, destinationPort);
+                    Date from, to;
+                    cout << "Enter start date (dd/mm/yy): ";
+                    getline(cin, text);
+                    bool valid = parseStoredDate(text, from);
+                    cout << "Enter end date (dd/mm/yy): ";
+                    getline(cin, text);
+                    if (!valid || !parseStoredDate(text, to))
+                    {
+                        cout << "Invalid date." << endl
+                             << endl;
+                        break;
+                    }
+                    RouteQuery query{internPool().find(departurePort), internPool().find(destinationPort), packDate(from), packDate(to)};
+                    vector<Sailing> sailings;
+                    findSailings(voyageTable, shipInventory, query, sailings);
+                    cout << endl;
+                    if (sailings.empty())
+                    {
+                        cout << "No sailings found." << endl
+                             << endl;
+                        break;
+                    }
+                    cout << "Sailings " << departurePort << " -> " << destinationPort << ":" << endl;
+                    for (const Sailing &sailing : sailings)
+                    {
+                        const Voyage &voyage = voyageTable.voyage(sailing.voyageId);
+                        string date;
+                        formatDate(date, voyage.date);
+                        cout << date << " " << internPool().view(voyage.shipId) << ": " << sailing.freeCabins[0] << " economy, "
+                             << sailing.freeCabins[1] << " business, " << sailing.freeCabins[2] << " first class cabins free" << endl;
+                    }
+                    cout << endl;
+                    break;
+                }
+                case 14:
+                {
+                    cout << endl;
+                    string text;
+                    cout << "Enter phone number (+380xxxxxxxxx) or beginning of name: ";
+                    cin.ignore();
+                    getline(cin, text);
+                    cout << endl;
+                    // ³      ,  -   
+                    if (isValidPhoneNumber(text))
+                    {
+                        const Passenger *passenger = passengers.findByPhone(text);
+                        if (passenger == nullptr)
+                        {
+                            cout << "No passenger with this phone number." << endl
+                                 << endl;
+                            break;
+                        }
+                        passenger->displayInfo();
+                        break;
+                    }
+                    const size_t shown = 20;
+                    vector<const Passenger *> found;
+                    size_t total = passengers.findByNamePrefix(text, shown, found);
+                    if (total == 0)
+                    {
+                        cout << "No passengers found." << endl
+                             << endl;
+                        break;
+                    }
+                    cout << "Passengers found: " << total;
+                    if (total > found.size())
+                    {
+                        cout << " (first " << found.size() << " shown)";
+                    }
+                    cout << endl;
+                    for (const Passenger *passenger : found)
+                    {
+                        cout << "ID " << passenger->id << ": " << passenger->name << ", " << passenger->phoneNumber << endl;
+                    }
+                    cout << endl;
+                    break;
+                }
+                case 15:
+                {
+                    // ˳     Prometheus (text exposition format)
+                    cout << endl;
+                    string text;
+                    writePrometheusMetrics(text);
+                    cout << text << endl;
+                    break;
+                }
                 default:
                     cout << "Invalid choice. Please enter a number from the menu." << endl
                          << endl;
@@ -1053,6 +1271,7 @@ int main()
             case 1:
             {
                 cout << endl;
+                background.flush(); //       
                 displayDataFromFile("passenger_data.txt");
                 cout << endl;
                 break;
@@ -1060,6 +1279,7 @@ int main()
             case 2:
             {
                 cout << endl;
+                background.flush();
                 displayDataFromFile("reservations.txt");
                 cout << endl;
                 break;
@@ -1082,13 +1302,20 @@ int main()
             break;
         }
     }
+    //       ;    
+    //   ,      
     cout << "Saving data to file before exiting..." << endl;
-    saveDataToFile(passengers, "passenger_data.txt");
-    cout << "Exiting program." << endl;
-
-    cout << "Saving reservations data to file before exiting..." << endl;
-    saveReservationsToFile(passengers, "reservations.txt");
-    cout << "Reservations saved to file successfully." << endl;
+    background.stop();
+    if (journal.compact(passengers, ticketTable, voyageTable))
+    {
+        cout << "Data saved to file successfully." << endl;
+        cout << "Reservations saved to file successfully." << endl;
+    }
+    else
+    {
+        cout << "Error saving data files." << endl;
+    }
+    journal.close();
     cout << "Exiting program." << endl;
 
     return 0;
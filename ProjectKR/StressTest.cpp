@@ -0,0 +1,259 @@
+#include "StressTest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ConcurrentBooking.h"
+#include "InternPool.h"
+#include "Validation.h"
+
+using namespace std;
+
+namespace
+{
+    // ʳ      
+    struct StatusCounts
+    {
+        atomic<size_t> counts[static_cast<size_t>(BookingStatus::InvalidCabin) + 1] = {};
+
+        void add(BookingStatus status) { counts[static_cast<size_t>(status)].fetch_add(1, memory_order_relaxed); }
+        size_t get(BookingStatus status) const { return counts[static_cast<size_t>(status)].load(); }
+    };
+
+    //    :  
+    const size_t voyagesPerShip = 4;
+
+    string stressShipName(size_t ship)
+    {
+        return "StressShip" + to_string(ship);
+    }
+
+    string stressPort(size_t port)
+    {
+        return "StressPort" + to_string(port);
+    }
+
+    //     :   
+    string stressPhone(int id)
+    {
+        string digits = to_string(id);
+        return "+38099" + string(7 - min<size_t>(digits.size(), 7), '0') + digits;
+    }
+
+    // ֳ   
+    double stressPrice(int cabinClass)
+    {
+        return cabinClass == 1 ? 100.0 : cabinClass == 2 ? 300.0 : 600.0;
+    }
+
+    bool fail(ostream &out, const string &message)
+    {
+        out << "FAILED: " << message << '\n';
+        return false;
+    }
+
+    //      
+    string voyageName(const BookingState &state, uint32_t voyageId)
+    {
+        const Voyage &voyage = state.voyages.voyage(voyageId);
+        string name(internPool().view(voyage.shipId));
+        name += " on ";
+        formatDate(name, voyage.date);
+        return name;
+    }
+
+    //      
+    bool verify(const BookingState &state, size_t shipCount, size_t booked, ostream &out)
+    {
+        bool ok = true;
+        if (state.tickets.size() != booked)
+        {
+            ok = fail(out, "ticket table has " + to_string(state.tickets.size()) + " rows, but " + to_string(booked) + " bookings succeeded");
+        }
+        if (state.voyages.size() > shipCount * voyagesPerShip)
+        {
+            ok = fail(out, to_string(state.voyages.size()) + " voyages were opened for " + to_string(shipCount * voyagesPerShip) + " departures");
+        }
+
+        //       
+        size_t voyageCount = state.voyages.size();
+        vector<int> classCounts(voyageCount * cabinClassCount, 0);
+        vector<int> ticketIds;
+        ticketIds.reserve(state.tickets.size());
+        vector<uint64_t> cabins; // (, )  
+        cabins.reserve(state.tickets.size());
+        for (uint32_t row = 0; row < state.tickets.size(); row++)
+        {
+            uint32_t voyageId = state.tickets.voyageId(row);
+            if (voyageId >= voyageCount || state.voyages.voyage(voyageId).shipId != state.tickets.shipId(row) ||
+                state.voyages.voyage(voyageId).date != state.tickets.date(row))
+            {
+                ok = fail(out, "ticket " + to_string(state.tickets.id(row)) + " does not match its voyage");
+                continue;
+            }
+            classCounts[voyageId * cabinClassCount + state.tickets.cabinClass(row) - 1]++;
+            ticketIds.push_back(state.tickets.id(row));
+            uint32_t cabin = state.tickets.cabin(row);
+            if (state.inventory.layout(voyageId).classOf(cabin) != state.tickets.cabinClass(row))
+            {
+                ok = fail(out, "ticket " + to_string(state.tickets.id(row)) + " has cabin " + to_string(cabin) + " outside its class");
+            }
+            cabins.push_back(static_cast<uint64_t>(voyageId) << 32 | cabin);
+        }
+
+        for (uint32_t voyageId = 0; voyageId < voyageCount; voyageId++)
+        {
+            int total = 0;
+            for (int cabinClass = 1; cabinClass <= cabinClassCount; cabinClass++)
+            {
+                int count = classCounts[voyageId * cabinClassCount + cabinClass - 1];
+                total += count;
+                if (count > static_cast<int>(state.inventory.layout(voyageId).cabins[cabinClass - 1]))
+                {
+                    ok = fail(out, voyageName(state, voyageId) + " class " + to_string(cabinClass) + " is overbooked: " + to_string(count));
+                }
+                if (state.inventory.passengersInClass(voyageId, cabinClass) != count)
+                {
+                    ok = fail(out, voyageName(state, voyageId) + " class " + to_string(cabinClass) + " inventory does not match the tickets");
+                }
+            }
+            if (total > state.inventory.capacity(voyageId))
+            {
+                ok = fail(out, voyageName(state, voyageId) + " is overbooked: " + to_string(total) + " passengers");
+            }
+        }
+
+        sort(ticketIds.begin(), ticketIds.end());
+        if (adjacent_find(ticketIds.begin(), ticketIds.end()) != ticketIds.end())
+        {
+            ok = fail(out, "a ticket ID was issued twice");
+        }
+        sort(cabins.begin(), cabins.end());
+        if (adjacent_find(cabins.begin(), cabins.end()) != cabins.end())
+        {
+            ok = fail(out, "a cabin was assigned to two tickets");
+        }
+
+        size_t passengerTickets = 0;
+        for (const Passenger &passenger : state.passengers)
+        {
+            if (passenger.tickets.size() > 1)
+            {
+                ok = fail(out, "passenger " + to_string(passenger.id) + " has " + to_string(passenger.tickets.size()) + " tickets");
+            }
+            passengerTickets += passenger.tickets.size();
+        }
+        if (passengerTickets != state.tickets.size())
+        {
+            ok = fail(out, "passengers hold " + to_string(passengerTickets) + " tickets, but the table has " + to_string(state.tickets.size()));
+        }
+        return ok;
+    }
+}
+
+bool runBookingStress(size_t cashiers, size_t attemptsPerCashier, ostream &out)
+{
+    cashiers = max<size_t>(cashiers, 1);
+    size_t attempts = cashiers * attemptsPerCashier;
+    //          ,
+    //     
+    size_t shipCount = max<size_t>(attempts / (4 * defaultCabinLayout.total() * voyagesPerShip), 1);
+    size_t passengersPerCashier = max<size_t>(attemptsPerCashier / 2, 1);
+    size_t passengerCount = cashiers * passengersPerCashier;
+
+    PassengerRegistry passengers;
+    TicketTable tickets;
+    IdRegistry usedIds;
+    IdRegistry usedTicketIds;
+    VoyageTable voyages;
+    ShipInventory inventory;
+    BookingState state{passengers, tickets, usedIds, usedTicketIds, voyages, inventory};
+    ConcurrentBooking booking(state);
+
+    vector<string> dates(voyagesPerShip);
+    for (size_t voyage = 0; voyage < voyagesPerShip; voyage++)
+    {
+        formatDate(dates[voyage], today() + 30 + 7 * static_cast<uint32_t>(voyage));
+    }
+
+    StatusCounts passengerStatuses;
+    StatusCounts ticketStatuses;
+    atomic<int> nextTicketId(1);
+
+    auto start = chrono::steady_clock::now();
+    vector<thread> threads;
+    for (size_t cashier = 0; cashier < cashiers; cashier++)
+    {
+        threads.emplace_back([&, cashier]
+                             {
+            mt19937 random(static_cast<unsigned>(cashier) + 1);
+
+            //      ID   
+            for (size_t i = 0; i < passengersPerCashier; i++)
+            {
+                int id = static_cast<int>(cashier * passengersPerCashier + i + 1);
+                passengerStatuses.add(booking.createPassenger("Stress Passenger", "Stress street", stressPhone(id), id));
+            }
+            passengerStatuses.add(booking.createPassenger("Stress Passenger", "Stress street", stressPhone(1), 1));
+
+            uniform_int_distribution<size_t> pickPassenger(1, passengerCount);
+            uniform_int_distribution<size_t> pickShip(0, shipCount - 1);
+            uniform_int_distribution<size_t> pickVoyage(0, voyagesPerShip - 1);
+            uniform_int_distribution<int> pickClass(1, cabinClassCount);
+            uniform_int_distribution<int> pickReuse(0, 15);
+            for (size_t i = 0; i < attemptsPerCashier; i++)
+            {
+                size_t ship = pickShip(random);
+                TicketRequest request;
+                request.passengerId = static_cast<int>(pickPassenger(random));
+                //       ID 
+                int issued = nextTicketId.load(memory_order_relaxed);
+                request.ticketId = pickReuse(random) == 0 && issued > 1
+                                       ? uniform_int_distribution<int>(1, issued - 1)(random)
+                                       : nextTicketId.fetch_add(1, memory_order_relaxed);
+                request.shipName = stressShipName(ship);
+                request.departurePort = stressPort(ship % 7);
+                request.destinationPort = stressPort(ship % 7 + 1);
+                request.date = dates[pickVoyage(random)];
+                request.cabinClass = pickClass(random);
+                request.price = stressPrice(request.cabinClass);
+                ticketStatuses.add(booking.issueTicket(request));
+            } });
+    }
+    for (thread &cashier : threads)
+    {
+        cashier.join();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    size_t booked = ticketStatuses.get(BookingStatus::Ok);
+    out << "Stress test: " << cashiers << " cashiers, " << shipCount << " ships, " << voyages.size() << " voyages, "
+        << passengers.size() << " passengers, "
+        << attempts << " booking attempts in " << seconds << " s";
+    if (seconds > 0)
+    {
+        out << " (" << static_cast<long long>(attempts / seconds) << " attempts/s)";
+    }
+    out << "." << '\n';
+    out << "Booked " << booked << ", ship full " << ticketStatuses.get(BookingStatus::ShipFull)
+        << ", class full " << ticketStatuses.get(BookingStatus::CabinClassFull)
+        << ", passenger has ticket " << ticketStatuses.get(BookingStatus::PassengerHasTicket)
+        << ", duplicate ticket ID " << ticketStatuses.get(BookingStatus::DuplicateTicketId)
+        << ", duplicate passenger ID " << passengerStatuses.get(BookingStatus::DuplicatePassengerId) << "." << '\n';
+
+    bool ok = verify(state, shipCount, booked, out);
+    if (passengers.size() != passengerCount)
+    {
+        ok = fail(out, "expected " + to_string(passengerCount) + " passengers, found " + to_string(passengers.size()));
+    }
+    if (ok)
+    {
+        out << "No overbooking: every voyage is within its capacity and cabin class limits." << '\n';
+    }
+    return ok;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+
+//   ConcurrentBooking ( --stress).
+//          
+//      ,      
+//   . ϳ   :   
+//     ,      ,
+//          ,  
+//    , ID   .
+//      '     .
+//  true,    .
+bool runBookingStress(size_t cashiers, size_t attemptsPerCashier, std::ostream &out);
@@ -0,0 +1,153 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <memory>
+
+using namespace std;
+
+namespace
+{
+    size_t requestedThreads = 0;
+    unique_ptr<ThreadPool> sharedPool;
+
+    size_t defaultThreadCount()
+    {
+        unsigned cores = thread::hardware_concurrency();
+        return cores > 0 ? cores : 1;
+    }
+}
+
+ThreadPool::ThreadPool(size_t threads) : queues(max<size_t>(threads, 1))
+{
+    for (size_t worker = 1; worker < queues.size(); worker++)
+    {
+        workers.emplace_back(&ThreadPool::workerLoop, this, worker);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        lock_guard<mutex> lock(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (thread &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+bool ThreadPool::takeTask(size_t worker, Task &task)
+{
+    //      (  ),     
+    for (size_t i = 0; i < queues.size(); i++)
+    {
+        Queue &queue = queues[(worker + i) % queues.size()];
+        lock_guard<mutex> lock(queue.lock);
+        if (queue.tasks.empty())
+        {
+            continue;
+        }
+        if (i == 0)
+        {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+        }
+        else
+        {
+            task = queue.tasks.back();
+            queue.tasks.pop_back();
+        }
+        queued--;
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::runTask(size_t worker, const Task &task)
+{
+    (*task.job->body)(worker, task.begin, task.end);
+    if (task.job->remaining.fetch_sub(1) == 1)
+    {
+        lock_guard<mutex> lock(doneLock);
+        done.notify_all();
+    }
+}
+
+void ThreadPool::workerLoop(size_t worker)
+{
+    while (true)
+    {
+        Task task;
+        if (takeTask(worker, task))
+        {
+            runTask(worker, task);
+            continue;
+        }
+        unique_lock<mutex> lock(sleepLock);
+        wake.wait(lock, [this]
+                  { return stopping || queued > 0; });
+        if (stopping && queued <= 0)
+        {
+            return;
+        }
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t morsel, const Body &body)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    morsel = max<size_t>(morsel, 1);
+    size_t tasks = (count + morsel - 1) / morsel;
+    if (tasks == 1 || workers.empty())
+    {
+        //  :       
+        for (size_t begin = 0; begin < count; begin += morsel)
+        {
+            body(0, begin, min(count, begin + morsel));
+        }
+        return;
+    }
+
+    Job job{&body, {tasks}};
+    //      
+    for (size_t i = 0; i < tasks; i++)
+    {
+        Queue &queue = queues[i * queues.size() / tasks];
+        lock_guard<mutex> lock(queue.lock);
+        queue.tasks.push_back(Task{&job, i * morsel, min(count, (i + 1) * morsel)});
+    }
+    {
+        lock_guard<mutex> lock(sleepLock);
+        queued += static_cast<ptrdiff_t>(tasks);
+    }
+    wake.notify_all();
+
+    Task task;
+    while (takeTask(0, task))
+    {
+        runTask(0, task);
+    }
+    unique_lock<mutex> lock(doneLock);
+    done.wait(lock, [&job]
+              { return job.remaining == 0; });
+}
+
+ThreadPool &threadPool()
+{
+    if (!sharedPool)
+    {
+        sharedPool.reset(new ThreadPool(requestedThreads > 0 ? requestedThreads : defaultThreadCount()));
+    }
+    return *sharedPool;
+}
+
+void setThreadPoolSize(size_t threads)
+{
+    requestedThreads = threads;
+    sharedPool.reset();
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//           .
+// ĳ     (morsels),    ; 
+//        ,    , 
+// ,      . ,  
+// parallelFor,   .       ,
+//   parallelFor    .
+class ThreadPool
+{
+public:
+    // threads -      ,   parallelFor
+    explicit ThreadPool(size_t threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    size_t size() const { return queues.size(); }
+
+    // ҳ    (0 - )    [begin, end)
+    using Body = std::function<void(size_t worker, size_t begin, size_t end)>;
+
+    //  body    [0, count)  ,   
+    void parallelFor(size_t count, size_t morsel, const Body &body);
+
+private:
+    struct Job
+    {
+        const Body *body;
+        std::atomic<size_t> remaining;
+    };
+
+    struct Task
+    {
+        Job *job;
+        size_t begin;
+        size_t end;
+    };
+
+    struct Queue
+    {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<Queue> queues; //    , 0 - 
+    std::vector<std::thread> workers;
+
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    std::atomic<std::ptrdiff_t> queued{0}; // ,     
+    bool stopping = false;
+
+    std::mutex doneLock;
+    std::condition_variable done;
+
+    bool takeTask(size_t worker, Task &task);
+    void runTask(size_t worker, const Task &task);
+    void workerLoop(size_t worker);
+};
+
+// ʳ   : 16K   uint32 - 64 , 
+//        L2  
+const size_t morselRows = 16384;
+
+//    ;    
+ThreadPool &threadPool();
+
+// ʳ   (0 -   );   
+void setThreadPoolSize(size_t threads);
+
+//  :      
+//  ,       
+template <typename Partial, typename Scan, typename Merge>
+Partial parallelAggregate(size_t count, const Partial &initial, Scan scan, Merge merge)
+{
+    //       ,      
+    struct alignas(64) Slot
+    {
+        Partial value;
+    };
+
+    ThreadPool &pool = threadPool();
+    std::vector<Slot> partials(pool.size(), Slot{initial});
+    pool.parallelFor(count, morselRows, [&](size_t worker, size_t begin, size_t end)
+                     { scan(partials[worker].value, begin, end); });
+
+    Partial result = std::move(partials[0].value);
+    for (size_t i = 1; i < partials.size(); i++)
+    {
+        merge(result, partials[i].value);
+    }
+    return result;
+}
@@ -0,0 +1,68 @@
+#include "TicketAggregate.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace std;
+
+void TicketAggregate::recordTicket(int cabinClass, uint32_t destinationId, double price)
+{
+    tickets++;
+
+    double sum = revenueSum + price;
+    if (fabs(revenueSum) >= fabs(price))
+    {
+        revenueCompensation += (revenueSum - sum) + price;
+    }
+    else
+    {
+        revenueCompensation += (price - sum) + revenueSum;
+    }
+    revenueSum = sum;
+
+    //       
+    uint8_t classIndex = static_cast<uint8_t>(cabinClass);
+    uint32_t classCount = ++classCounts[classIndex];
+    if (classCount > maxClassCount)
+    {
+        maxClassCount = classCount;
+        memset(topClasses, 0, sizeof(topClasses));
+    }
+    if (classCount == maxClassCount)
+    {
+        topClasses[classIndex >> 6] |= uint64_t(1) << (classIndex & 63);
+    }
+
+    if (destinationId >= destinationCounts.size())
+    {
+        destinationCounts.resize(destinationId + 1, 0);
+    }
+    uint32_t destinationCount = ++destinationCounts[destinationId];
+    if (destinationCount > maxDestinationCount)
+    {
+        maxDestinationCount = destinationCount;
+        topDestinations.clear();
+    }
+    if (destinationCount == maxDestinationCount)
+    {
+        topDestinations.push_back(destinationId);
+    }
+}
+
+void TicketAggregate::clear()
+{
+    *this = TicketAggregate();
+}
+
+vector<int> TicketAggregate::mostPopularCabinClasses() const
+{
+    vector<int> classes;
+    for (int cabinClass = 0; cabinClass < 256; cabinClass++)
+    {
+        if (topClasses[cabinClass >> 6] & (uint64_t(1) << (cabinClass & 63)))
+        {
+            classes.push_back(cabinClass);
+        }
+    }
+    return classes;
+}
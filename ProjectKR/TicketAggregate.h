@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ϳ   ,      :
+//  ,        
+//      .  
+// ,       
+//   O(1)  .
+class TicketAggregate
+{
+public:
+    void recordTicket(int cabinClass, uint32_t destinationId, double price);
+    void clear();
+
+    size_t ticketCount() const { return tickets; }
+    double revenue() const { return revenueSum + revenueCompensation; }
+
+    //      ,  
+    std::vector<int> mostPopularCabinClasses() const;
+
+    //    ( internPool())    
+    const std::vector<uint32_t> &mostPopularDestinations() const { return topDestinations; }
+
+private:
+    size_t tickets = 0;
+
+    //     (),      
+    double revenueSum = 0.0;
+    double revenueCompensation = 0.0;
+
+    uint32_t classCounts[256] = {};
+    uint32_t maxClassCount = 0;
+    uint64_t topClasses[4] = {}; //     maxClassCount
+
+    std::vector<uint32_t> destinationCounts; //  -  
+    uint32_t maxDestinationCount = 0;
+    std::vector<uint32_t> topDestinations;
+};
@@ -0,0 +1,67 @@
+#include "TicketTable.h"
+
+#include "Validation.h"
+
+using namespace std;
+
+uint32_t TicketTable::add(int id, uint32_t voyageId, const Voyage &route, int cabinClass, uint32_t cabin, double price)
+{
+    uint32_t row = static_cast<uint32_t>(ids.size());
+    ids.push_back(id);
+    voyageIds.push_back(voyageId);
+    shipIds.push_back(route.shipId);
+    departureIds.push_back(route.departurePort);
+    destinationIds.push_back(route.destinationPort);
+    dates.push_back(route.date);
+    cabinClasses.push_back(static_cast<uint8_t>(cabinClass));
+    cabins.push_back(static_cast<uint16_t>(cabin));
+    prices.push_back(price);
+
+    totals.recordTicket(cabinClass, route.destinationPort, price);
+    ticketPopularity.recordTicket(route.departurePort, route.destinationPort, route.date);
+    ticketDates.add(route.date, row);
+    return row;
+}
+
+void TicketTable::reserve(size_t count)
+{
+    ids.reserve(count);
+    voyageIds.reserve(count);
+    shipIds.reserve(count);
+    departureIds.reserve(count);
+    destinationIds.reserve(count);
+    dates.reserve(count);
+    cabinClasses.reserve(count);
+    cabins.reserve(count);
+    prices.reserve(count);
+    ticketDates.reserve(count);
+}
+
+void TicketTable::clear()
+{
+    ids.clear();
+    voyageIds.clear();
+    shipIds.clear();
+    departureIds.clear();
+    destinationIds.clear();
+    dates.clear();
+    cabinClasses.clear();
+    cabins.clear();
+    prices.clear();
+    ticketDates.clear();
+    totals.clear();
+    ticketPopularity = TicketPopularity(popularityOptions);
+}
+
+void TicketTable::setPopularityOptions(const TopKOptions &options)
+{
+    popularityOptions = options;
+    ticketPopularity = TicketPopularity(options);
+}
+
+string TicketTable::dateText(uint32_t row) const
+{
+    string text;
+    formatDate(text, dates[row]);
+    return text;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "DateIndex.h"
+#include "InternPool.h"
+#include "Models.h"
+#include "TicketAggregate.h"
+#include "TopK.h"
+
+//   :     ,     
+struct TicketFields
+{
+    int id = 0;
+    Voyage route; // ,   
+    int cabinClass = 0;
+    uint32_t cabin = 0; // 0 -   
+    double price = 0.0;
+};
+
+//   ,     (structure of arrays).
+//   -  ;      .
+//       VoyageTable,   , 
+//    (  internPool()),     
+//      .
+//        ( -  ),
+//  TicketAggregate       top-K 
+//    .
+class TicketTable
+{
+public:
+    //     voyageId;   . route - ,
+    //    , cabin -   (0 -  )
+    uint32_t add(int id, uint32_t voyageId, const Voyage &route, int cabinClass, uint32_t cabin, double price);
+
+    void reserve(size_t count);
+    void clear();
+
+    //   ;    ,
+    //       
+    void setPopularityOptions(const TopKOptions &options);
+
+    size_t size() const { return ids.size(); }
+    bool empty() const { return ids.empty(); }
+
+    int id(uint32_t row) const { return ids[row]; }
+    uint32_t voyageId(uint32_t row) const { return voyageIds[row]; }
+    uint32_t shipId(uint32_t row) const { return shipIds[row]; }
+    uint32_t departureId(uint32_t row) const { return departureIds[row]; }
+    uint32_t destinationId(uint32_t row) const { return destinationIds[row]; }
+    std::string_view shipName(uint32_t row) const { return internPool().view(shipIds[row]); }
+    std::string_view departurePort(uint32_t row) const { return internPool().view(departureIds[row]); }
+    std::string_view destinationPort(uint32_t row) const { return internPool().view(destinationIds[row]); }
+    uint32_t date(uint32_t row) const { return dates[row]; }
+    std::string dateText(uint32_t row) const;
+    int cabinClass(uint32_t row) const { return cabinClasses[row]; }
+    uint32_t cabin(uint32_t row) const { return cabins[row]; }
+    double price(uint32_t row) const { return prices[row]; }
+
+    TicketFields fields(uint32_t row) const
+    {
+        return TicketFields{ids[row], Voyage(shipIds[row], departureIds[row], destinationIds[row], dates[row]),
+                            cabinClasses[row], cabins[row], prices[row]};
+    }
+
+    //    
+    const int32_t *idColumn() const { return ids.data(); }
+    const uint32_t *voyageColumn() const { return voyageIds.data(); }
+    const uint32_t *shipColumn() const { return shipIds.data(); }
+    const uint32_t *departureColumn() const { return departureIds.data(); }
+    const uint32_t *destinationColumn() const { return destinationIds.data(); }
+    const uint32_t *dateColumn() const { return dates.data(); }
+    const uint8_t *cabinClassColumn() const { return cabinClasses.data(); }
+    const uint16_t *cabinColumn() const { return cabins.data(); }
+    const double *priceColumn() const { return prices.data(); }
+
+    const DateIndex &ticketsByDate() const { return ticketDates; }
+    const TicketAggregate &aggregate() const { return totals; }
+    const TicketPopularity &popularity() const { return ticketPopularity; }
+
+private:
+    std::vector<int32_t> ids;
+    std::vector<uint32_t> voyageIds;
+    std::vector<uint32_t> shipIds;
+    std::vector<uint32_t> departureIds;
+    std::vector<uint32_t> destinationIds;
+    std::vector<uint32_t> dates;
+    std::vector<uint8_t> cabinClasses;
+    std::vector<uint16_t> cabins; //     maxCabinsPerClass
+    std::vector<double> prices;
+
+    DateIndex ticketDates;
+    TicketAggregate totals;
+    TopKOptions popularityOptions;
+    TicketPopularity ticketPopularity;
+};
@@ -0,0 +1,393 @@
+#include "TopK.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace
+{
+    //    ( MurmurHash3)
+    uint64_t mix(uint64_t key)
+    {
+        key ^= key >> 33;
+        key *= 0xFF51AFD7ED558CCDULL;
+        key ^= key >> 33;
+        key *= 0xC4CEB9FE1A85EC53ULL;
+        key ^= key >> 33;
+        return key;
+    }
+
+    //       :   
+    const uint32_t defaultBucketDays = 7;
+    const size_t defaultBucketCount = 53;
+
+    bool countGreater(const TopKItem &a, const TopKItem &b)
+    {
+        return a.count > b.count || (a.count == b.count && a.key < b.key);
+    }
+}
+
+CountMinSketch::CountMinSketch(size_t width, size_t depth) : width(1), depth(max<size_t>(depth, 1))
+{
+    //  -  ,    ,   
+    while (this->width < width)
+    {
+        this->width *= 2;
+    }
+    cells.assign(this->width * this->depth, 0);
+}
+
+size_t CountMinSketch::cell(size_t row, uint64_t hash) const
+{
+    //     h1 + row * h2    
+    uint64_t h1 = hash;
+    uint64_t h2 = (hash >> 32) | 1;
+    return row * width + static_cast<size_t>((h1 + row * h2) & (width - 1));
+}
+
+void CountMinSketch::add(uint64_t key, uint64_t count)
+{
+    uint64_t hash = mix(key);
+    for (size_t row = 0; row < depth; row++)
+    {
+        cells[cell(row, hash)] += count;
+    }
+}
+
+uint64_t CountMinSketch::estimate(uint64_t key) const
+{
+    uint64_t hash = mix(key);
+    uint64_t result = UINT64_MAX;
+    for (size_t row = 0; row < depth; row++)
+    {
+        result = min(result, cells[cell(row, hash)]);
+    }
+    return result;
+}
+
+void CountMinSketch::merge(const CountMinSketch &other)
+{
+    //      -  
+    for (size_t i = 0; i < cells.size() && i < other.cells.size(); i++)
+    {
+        cells[i] += other.cells[i];
+    }
+}
+
+uint64_t CountMinSketch::errorBound(uint64_t total) const
+{
+    return static_cast<uint64_t>(ceil(exp(1.0) * static_cast<double>(total) / static_cast<double>(width)));
+}
+
+SpaceSaving::SpaceSaving(size_t capacity) : capacity(max<size_t>(capacity, 1))
+{
+    size_t size = 16;
+    while (size < this->capacity * 2)
+    {
+        size *= 2;
+    }
+    slots.assign(size, emptySlot);
+}
+
+size_t SpaceSaving::slotOf(uint64_t key) const
+{
+    return static_cast<size_t>(mix(key)) & (slots.size() - 1);
+}
+
+uint32_t SpaceSaving::findSlot(uint64_t key) const
+{
+    size_t mask = slots.size() - 1;
+    for (size_t i = slotOf(key);; i = (i + 1) & mask)
+    {
+        if (slots[i] == emptySlot || items[slots[i]].key == key)
+        {
+            return static_cast<uint32_t>(i);
+        }
+    }
+}
+
+void SpaceSaving::insertSlot(uint64_t key, uint32_t item)
+{
+    slots[findSlot(key)] = item;
+}
+
+void SpaceSaving::eraseSlot(uint64_t key)
+{
+    size_t mask = slots.size() - 1;
+    size_t hole = findSlot(key);
+    if (slots[hole] == emptySlot)
+    {
+        return;
+    }
+    //   ,        ,  
+    for (size_t i = (hole + 1) & mask; slots[i] != emptySlot; i = (i + 1) & mask)
+    {
+        size_t home = slotOf(items[slots[i]].key);
+        if (((i - home) & mask) >= ((i - hole) & mask))
+        {
+            slots[hole] = slots[i];
+            hole = i;
+        }
+    }
+    slots[hole] = emptySlot;
+}
+
+void SpaceSaving::swapNodes(size_t a, size_t b)
+{
+    swap(heap[a], heap[b]);
+    position[heap[a]] = static_cast<uint32_t>(a);
+    position[heap[b]] = static_cast<uint32_t>(b);
+}
+
+void SpaceSaving::siftUp(size_t i)
+{
+    while (i > 0)
+    {
+        size_t parent = (i - 1) / 2;
+        if (items[heap[parent]].count <= items[heap[i]].count)
+        {
+            break;
+        }
+        swapNodes(i, parent);
+        i = parent;
+    }
+}
+
+void SpaceSaving::siftDown(size_t i)
+{
+    while (true)
+    {
+        size_t smallest = i;
+        size_t left = 2 * i + 1;
+        size_t right = left + 1;
+        if (left < heap.size() && items[heap[left]].count < items[heap[smallest]].count)
+        {
+            smallest = left;
+        }
+        if (right < heap.size() && items[heap[right]].count < items[heap[smallest]].count)
+        {
+            smallest = right;
+        }
+        if (smallest == i)
+        {
+            break;
+        }
+        swapNodes(i, smallest);
+        i = smallest;
+    }
+}
+
+void SpaceSaving::add(uint64_t key, uint64_t count)
+{
+    uint32_t slot = findSlot(key);
+    if (slots[slot] != emptySlot)
+    {
+        uint32_t item = slots[slot];
+        items[item].count += count;
+        siftDown(position[item]);
+        return;
+    }
+    if (items.size() < capacity)
+    {
+        uint32_t item = static_cast<uint32_t>(items.size());
+        items.push_back(Entry{key, count, 0});
+        heap.push_back(item);
+        position.push_back(static_cast<uint32_t>(heap.size() - 1));
+        slots[slot] = item;
+        siftUp(heap.size() - 1);
+        return;
+    }
+
+    //     
+    uint32_t item = heap[0];
+    Entry &entry = items[item];
+    eraseSlot(entry.key);
+    entry.key = key;
+    entry.error = entry.count;
+    entry.count += count;
+    insertSlot(key, item);
+    siftDown(0);
+}
+
+uint64_t SpaceSaving::minCount() const
+{
+    return items.size() < capacity || heap.empty() ? 0 : items[heap[0]].count;
+}
+
+void SpaceSaving::rebuild(vector<Entry> &&entries)
+{
+    items = move(entries);
+    heap.resize(items.size());
+    position.resize(items.size());
+    slots.assign(slots.size(), emptySlot);
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        heap[i] = static_cast<uint32_t>(i);
+        position[i] = static_cast<uint32_t>(i);
+        insertSlot(items[i].key, static_cast<uint32_t>(i));
+    }
+    for (size_t i = heap.size() / 2; i-- > 0;)
+    {
+        siftDown(i);
+    }
+}
+
+void SpaceSaving::merge(const SpaceSaving &other)
+{
+    // ,     ,     minCount ,
+    //       ,   
+    uint64_t ownMin = minCount();
+    uint64_t otherMin = other.minCount();
+    unordered_map<uint64_t, Entry> merged;
+    merged.reserve(items.size() + other.items.size());
+    for (const Entry &entry : items)
+    {
+        merged.emplace(entry.key, Entry{entry.key, entry.count + otherMin, entry.error + otherMin});
+    }
+    for (const Entry &entry : other.items)
+    {
+        auto found = merged.find(entry.key);
+        if (found == merged.end())
+        {
+            merged.emplace(entry.key, Entry{entry.key, entry.count + ownMin, entry.error + ownMin});
+        }
+        else
+        {
+            found->second.count += entry.count - otherMin;
+            found->second.error += entry.error - otherMin;
+        }
+    }
+
+    vector<Entry> entries;
+    entries.reserve(merged.size());
+    for (const auto &item : merged)
+    {
+        entries.push_back(item.second);
+    }
+    if (entries.size() > capacity)
+    {
+        nth_element(entries.begin(), entries.begin() + static_cast<ptrdiff_t>(capacity), entries.end(),
+                    [](const Entry &a, const Entry &b)
+                    { return a.count > b.count; });
+        entries.resize(capacity);
+    }
+    rebuild(move(entries));
+}
+
+TopKCounter::TopKCounter(const TopKOptions &options)
+    : options(options), events(0),
+      candidates(options.mode == TopKMode::Sketch ? options.capacity : 1),
+      sketch(options.mode == TopKMode::Sketch ? options.sketchWidth : 1, options.mode == TopKMode::Sketch ? options.sketchDepth : 1)
+{
+}
+
+void TopKCounter::add(uint64_t key, uint64_t count)
+{
+    events += count;
+    if (options.mode == TopKMode::Exact)
+    {
+        exact[key] += count;
+        return;
+    }
+    candidates.add(key, count);
+    sketch.add(key, count);
+}
+
+void TopKCounter::merge(const TopKCounter &other)
+{
+    events += other.events;
+    if (options.mode == TopKMode::Exact)
+    {
+        for (const auto &entry : other.exact)
+        {
+            exact[entry.first] += entry.second;
+        }
+        return;
+    }
+    candidates.merge(other.candidates);
+    sketch.merge(other.sketch);
+}
+
+TopKResult TopKCounter::top(size_t k) const
+{
+    TopKResult result;
+    result.total = events;
+    result.exact = options.mode == TopKMode::Exact;
+
+    if (result.exact)
+    {
+        for (const auto &entry : exact)
+        {
+            result.items.push_back(TopKItem{entry.first, entry.second, entry.second, entry.second});
+        }
+    }
+    else
+    {
+        //   -  Space-Saving (N / capacity);  Count-Min
+        //    .      
+        //   Count-Min,        .
+        result.maxError = events / options.capacity;
+        result.probableError = sketch.errorBound(events);
+        for (const SpaceSaving::Entry &entry : candidates.entries())
+        {
+            uint64_t upper = min(entry.count, sketch.estimate(entry.key));
+            uint64_t lower = entry.count - entry.error;
+            result.items.push_back(TopKItem{entry.key, upper, lower, upper});
+        }
+    }
+
+    size_t count = min(k, result.items.size());
+    partial_sort(result.items.begin(), result.items.begin() + static_cast<ptrdiff_t>(count), result.items.end(), countGreater);
+    result.items.resize(count);
+    return result;
+}
+
+WindowedTopK::WindowedTopK(const TopKOptions &options, uint32_t bucketDays, size_t bucketCount)
+    : options(options), bucketDays(max<uint32_t>(bucketDays, 1)), bucketCount(max<size_t>(bucketCount, 1)), overall(options)
+{
+}
+
+void WindowedTopK::add(uint64_t key, uint32_t day)
+{
+    overall.add(key);
+
+    uint32_t bucket = day / bucketDays;
+    auto found = buckets.find(bucket);
+    if (found == buckets.end())
+    {
+        // 䳿,     ,   
+        if (buckets.size() >= bucketCount && bucket < buckets.begin()->first)
+        {
+            return;
+        }
+        found = buckets.emplace(bucket, TopKCounter(options)).first;
+        if (buckets.size() > bucketCount)
+        {
+            buckets.erase(buckets.begin());
+        }
+    }
+    found->second.add(key);
+}
+
+TopKResult WindowedTopK::top(size_t k, uint32_t from, uint32_t to) const
+{
+    TopKCounter window(options);
+    for (auto bucket = buckets.lower_bound(from / bucketDays); bucket != buckets.end() && bucket->first <= to / bucketDays; ++bucket)
+    {
+        window.merge(bucket->second);
+    }
+    return window.top(k);
+}
+
+TicketPopularity::TicketPopularity(const TopKOptions &options)
+    : destinationTop(options, defaultBucketDays, defaultBucketCount),
+      routeTop(options, defaultBucketDays, defaultBucketCount)
+{
+}
+
+void TicketPopularity::recordTicket(uint32_t departureId, uint32_t destinationId, uint32_t date)
+{
+    destinationTop.add(destinationId, date);
+    routeTop.add(routeKey(departureId, destinationId), date);
+}
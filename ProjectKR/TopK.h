@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+//     (top-K).
+//       .   
+//  ': Space-Saving  capacity ,  Count-Min
+//    ,       .
+
+enum class TopKMode
+{
+    Exact,
+    Sketch
+};
+
+struct TopKOptions
+{
+    TopKMode mode = TopKMode::Sketch;
+    size_t capacity = 1024;    //  Space-Saving
+    size_t sketchWidth = 2048; //  Count-Min
+    size_t sketchDepth = 4;    //  Count-Min ( -)
+};
+
+//  :     [lowerBound, upperBound]
+struct TopKItem
+{
+    uint64_t key;
+    uint64_t count;
+    uint64_t lowerBound;
+    uint64_t upperBound;
+};
+
+struct TopKResult
+{
+    std::vector<TopKItem> items; //   count
+    uint64_t total = 0;          //   䳿
+    //     (0   ) -  Space-Saving
+    // total / capacity.    -    
+    // maxError    .
+    uint64_t maxError = 0;
+    //   Count-Min e * total / width,    
+    //  1 - e^-depth (0   );   
+    uint64_t probableError = 0;
+    bool exact = true;
+};
+
+//  Count-Min:         
+//  1 - e^-depth       e * total / width
+class CountMinSketch
+{
+public:
+    CountMinSketch(size_t width, size_t depth);
+
+    void add(uint64_t key, uint64_t count);
+    uint64_t estimate(uint64_t key) const;
+    void merge(const CountMinSketch &other);
+
+    uint64_t errorBound(uint64_t total) const;
+
+private:
+    size_t width;
+    size_t depth;
+    std::vector<uint64_t> cells; // depth   width 
+
+    size_t cell(size_t row, uint64_t hash) const;
+};
+
+// Space-Saving: capacity ;   ,   
+//          
+class SpaceSaving
+{
+public:
+    explicit SpaceSaving(size_t capacity);
+
+    void add(uint64_t key, uint64_t count);
+    void merge(const SpaceSaving &other);
+
+    //    ,     ( 0)
+    uint64_t minCount() const;
+
+    struct Entry
+    {
+        uint64_t key;
+        uint64_t count;
+        uint64_t error;
+    };
+
+    const std::vector<Entry> &entries() const { return items; }
+
+private:
+    size_t capacity;
+    std::vector<Entry> items;
+    std::vector<uint32_t> heap;     // ̳-  items  count
+    std::vector<uint32_t> position; //     
+
+    //  -  ->      
+    //   ;  ,     capacity
+    std::vector<uint32_t> slots; //    emptySlot
+    static constexpr uint32_t emptySlot = UINT32_MAX;
+
+    size_t slotOf(uint64_t key) const;
+    uint32_t findSlot(uint64_t key) const;
+    void insertSlot(uint64_t key, uint32_t item);
+    void eraseSlot(uint64_t key);
+
+    void siftUp(size_t i);
+    void siftDown(size_t i);
+    void swapNodes(size_t a, size_t b);
+    void rebuild(std::vector<Entry> &&entries);
+};
+
+// ˳ top-K   
+class TopKCounter
+{
+public:
+    explicit TopKCounter(const TopKOptions &options);
+
+    void add(uint64_t key, uint64_t count = 1);
+    void merge(const TopKCounter &other);
+
+    TopKResult top(size_t k) const;
+    uint64_t total() const { return events; }
+
+private:
+    TopKOptions options;
+    uint64_t events;
+    std::unordered_map<uint64_t, uint64_t> exact;
+    SpaceSaving candidates;
+    CountMinSketch sketch;
+};
+
+// top-K    : 䳿     bucketDays
+// ,   bucketCount  .   
+//  ' ,   ,     .
+class WindowedTopK
+{
+public:
+    WindowedTopK(const TopKOptions &options, uint32_t bucketDays, size_t bucketCount);
+
+    void add(uint64_t key, uint32_t day);
+
+    //   
+    TopKResult top(size_t k) const { return overall.top(k); }
+
+    //     [from, to] ( )
+    TopKResult top(size_t k, uint32_t from, uint32_t to) const;
+
+private:
+    TopKOptions options;
+    uint32_t bucketDays;
+    size_t bucketCount;
+    TopKCounter overall;
+    std::map<uint32_t, TopKCounter> buckets; //   -> 
+};
+
+//     ,     
+class TicketPopularity
+{
+public:
+    TicketPopularity() : TicketPopularity(TopKOptions()) {}
+    explicit TicketPopularity(const TopKOptions &options);
+
+    void recordTicket(uint32_t departureId, uint32_t destinationId, uint32_t date);
+
+    const WindowedTopK &destinations() const { return destinationTop; }
+    const WindowedTopK &routes() const { return routeTop; }
+
+    //        
+    static uint64_t routeKey(uint32_t departureId, uint32_t destinationId)
+    {
+        return (static_cast<uint64_t>(departureId) << 32) | destinationId;
+    }
+    static uint32_t routeDeparture(uint64_t key) { return static_cast<uint32_t>(key >> 32); }
+    static uint32_t routeDestination(uint64_t key) { return static_cast<uint32_t>(key); }
+
+private:
+    WindowedTopK destinationTop;
+    WindowedTopK routeTop;
+};
@@ -0,0 +1,284 @@
+#include "Validation.h"
+
+#include <cstring>
+#include <ctime>
+
+#include "Metrics.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PROJECTKR_HAVE_SSE2 1
+#endif
+
+using namespace std;
+
+namespace
+{
+    const size_t phoneLength = 13; // "+380"  9 
+    const size_t dateLength = 8;   // "dd/mm/yy"
+
+    //   12   "+",    
+    uint64_t phoneDigitsToNumber(const char *text)
+    {
+        uint64_t value = 0;
+        for (size_t i = 1; i < phoneLength; i++)
+        {
+            value = value * 10 + static_cast<uint64_t>(text[i] - '0');
+        }
+        return value;
+    }
+
+    uint64_t parsePhoneScalar(const char *text)
+    {
+        if (text[0] != '+' || text[1] != '3' || text[2] != '8' || text[3] != '0')
+        {
+            return 0;
+        }
+        for (size_t i = 4; i < phoneLength; i++)
+        {
+            if (static_cast<unsigned char>(text[i] - '0') > 9)
+            {
+                return 0;
+            }
+        }
+        return phoneDigitsToNumber(text);
+    }
+
+#ifdef PROJECTKR_HAVE_SSE2
+    //   13    16- 
+    uint64_t parsePhoneSse2(const char *text)
+    {
+        char buffer[16] = {0};
+        memcpy(buffer, text, phoneLength);
+        __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buffer));
+
+        //  "+380"   
+        const __m128i prefix = _mm_setr_epi8('+', '3', '8', '0', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+        int prefixMask = _mm_movemask_epi8(_mm_cmpeq_epi8(chars, prefix)) & 0x000F;
+
+        //  -  ,   min(c - '0', 9) == c - '0' ()
+        __m128i shifted = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+        __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(9)), shifted);
+        int digitMask = _mm_movemask_epi8(isDigit) & 0x1FF0;
+
+        if (prefixMask != 0x000F || digitMask != 0x1FF0)
+        {
+            return 0;
+        }
+        return phoneDigitsToNumber(text);
+    }
+#endif
+
+    int daysInMonth(int month, int year)
+    {
+        switch (month)
+        {
+        case 1:
+        case 3:
+        case 5:
+        case 7:
+        case 8:
+        case 10:
+        case 12:
+            return 31;
+        case 4:
+        case 6:
+        case 9:
+        case 11:
+            return 30;
+        case 2:
+            //         
+            return ((year % 4 == 0 && year % 100 != 0) || (year % 400 == 0)) ? 29 : 28;
+        default:
+            return 0;
+        }
+    }
+
+    YearWindow currentYearWindow()
+    {
+        int year = unpackDate(today()).year;
+        return YearWindow{year, year + 1};
+    }
+
+    YearWindow yearWindow = currentYearWindow();
+
+    bool checkCalendar(int day, int month, int year, bool checkYears)
+    {
+        if (checkYears && (year < yearWindow.first || year > yearWindow.last))
+        {
+            return false;
+        }
+        if (month < 1 || month > 12)
+        {
+            return false;
+        }
+        return day >= 1 && day <= daysInMonth(month, year);
+    }
+
+    //   dd/mm/yy  8    64-  (SWAR):
+    //        3,     9
+    bool parseDateSwar(const char *text, Date &date, bool checkYears)
+    {
+        uint64_t word;
+        memcpy(&word, text, dateLength);
+
+        //   little-endian  (x86/x64):  2  5 -  '/'
+        const uint64_t digitPositions = 0xFFFF00FFFF00FFFFULL;
+        const uint64_t slashPositions = 0x0000FF0000FF0000ULL;
+        const uint64_t slashes = 0x00002F00002F0000ULL;
+
+        if ((word & slashPositions) != slashes)
+        {
+            return false;
+        }
+        uint64_t digits = word & digitPositions;
+        if ((digits & (0xF0F0F0F0F0F0F0F0ULL & digitPositions)) != (0x3030303030303030ULL & digitPositions))
+        {
+            return false;
+        }
+        //  6         10..15
+        if (((digits & (0x0F0F0F0F0F0F0F0FULL & digitPositions)) + (0x0606060606060606ULL & digitPositions)) & (0xF0F0F0F0F0F0F0F0ULL & digitPositions))
+        {
+            return false;
+        }
+
+        int day = (text[0] - '0') * 10 + (text[1] - '0');
+        int month = (text[3] - '0') * 10 + (text[4] - '0');
+        int year = (text[6] - '0') * 10 + (text[7] - '0');
+        if (!checkCalendar(day, month, year, checkYears))
+        {
+            return false;
+        }
+        date.day = day;
+        date.month = month;
+        date.year = year;
+        return true;
+    }
+}
+
+uint64_t parsePhoneNumber(string_view number)
+{
+    METRIC_TIMER(ValidatePhone);
+    uint64_t value = number.size() == phoneLength ? parsePhoneScalar(number.data()) : 0;
+    if (value == 0)
+    {
+        METRIC_COUNT(InvalidInput, 1);
+    }
+    return value;
+}
+
+bool parseDate(string_view text, Date &date)
+{
+    METRIC_TIMER(ValidateDate);
+    bool ok = text.size() == dateLength && parseDateSwar(text.data(), date, true);
+    if (!ok)
+    {
+        METRIC_COUNT(InvalidInput, 1);
+    }
+    return ok;
+}
+
+bool parseStoredDate(string_view text, Date &date)
+{
+    METRIC_TIMER(ValidateDate);
+    bool ok = text.size() == dateLength && parseDateSwar(text.data(), date, false);
+    if (!ok)
+    {
+        METRIC_COUNT(InvalidInput, 1);
+    }
+    return ok;
+}
+
+YearWindow ticketYearWindow()
+{
+    return yearWindow;
+}
+
+void setTicketYearWindow(const YearWindow &window)
+{
+    yearWindow = window;
+}
+
+//          
+// ( days_from_civil / civil_from_days  ճ)
+uint32_t packDate(const Date &date)
+{
+    int year = 2000 + date.year - (date.month <= 2 ? 1 : 0);
+    int era = year / 400;
+    int yearOfEra = year - era * 400;
+    int dayOfYear = (153 * (date.month + (date.month > 2 ? -3 : 9)) + 2) / 5 + date.day - 1;
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return static_cast<uint32_t>(era * 146097 + dayOfEra - 719468);
+}
+
+Date unpackDate(uint32_t packed)
+{
+    int days = static_cast<int>(packed) + 719468;
+    int era = days / 146097;
+    int dayOfEra = days - era * 146097;
+    int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int monthIndex = (5 * dayOfYear + 2) / 153;
+    Date date;
+    date.day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    date.month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+    date.year = yearOfEra + era * 400 + (date.month <= 2 ? 1 : 0) - 2000;
+    return date;
+}
+
+uint32_t today()
+{
+    //   01/01/1970  UTC;        
+    return static_cast<uint32_t>(time(nullptr) / 86400);
+}
+
+void formatDate(string &out, uint32_t packed)
+{
+    Date date = unpackDate(packed);
+    char text[dateLength];
+    text[0] = static_cast<char>('0' + date.day / 10);
+    text[1] = static_cast<char>('0' + date.day % 10);
+    text[2] = '/';
+    text[3] = static_cast<char>('0' + date.month / 10);
+    text[4] = static_cast<char>('0' + date.month % 10);
+    text[5] = '/';
+    text[6] = static_cast<char>('0' + date.year / 10);
+    text[7] = static_cast<char>('0' + date.year % 10);
+    out.append(text, dateLength);
+}
+
+size_t validatePhoneNumbers(const string_view *numbers, size_t count, uint64_t *parsed)
+{
+    METRIC_TIMER(ValidatePhoneBatch);
+    size_t validCount = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        uint64_t value = 0;
+        if (numbers[i].size() == phoneLength)
+        {
+#ifdef PROJECTKR_HAVE_SSE2
+            value = parsePhoneSse2(numbers[i].data());
+#else
+            value = parsePhoneScalar(numbers[i].data());
+#endif
+        }
+        parsed[i] = value;
+        validCount += value != 0;
+    }
+    METRIC_COUNT(InvalidInput, count - validCount);
+    return validCount;
+}
+
+size_t validateDates(const string_view *dates, size_t count, Date *parsed, uint8_t *valid)
+{
+    METRIC_TIMER(ValidateDateBatch);
+    size_t validCount = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        bool ok = dates[i].size() == dateLength && parseDateSwar(dates[i].data(), parsed[i], true);
+        valid[i] = ok ? 1 : 0;
+        validCount += ok;
+    }
+    METRIC_COUNT(InvalidInput, count - validCount);
+    return validCount;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+//    dd/mm/yy  
+struct Date
+{
+    int day;
+    int month;
+    int year; //    
+};
+
+// ĳ  (  ),     .
+//   -       .
+struct YearWindow
+{
+    int first;
+    int last;
+};
+
+YearWindow ticketYearWindow();
+void setTicketYearWindow(const YearWindow &window);
+
+//      +380xxxxxxxxx.
+//    "+"   (380xxxxxxxxx)  0,   .
+uint64_t parsePhoneNumber(std::string_view number);
+
+//     dd/mm/yy      .
+//  false,   ;  date  .
+bool parseDate(std::string_view text, Date &date);
+
+//     :     ,  
+//    (      )
+bool parseStoredDate(std::string_view text, Date &date);
+
+//    -    01/01/1970 ( yy -  20yy).
+// г  -    ; 0     .
+uint32_t packDate(const Date &date);
+Date unpackDate(uint32_t packed);
+
+//      
+uint32_t today();
+
+//     dd/mm/yy
+void formatDate(std::string &out, uint32_t packed);
+
+inline bool isValidPhoneNumber(std::string_view number)
+{
+    return parsePhoneNumber(number) != 0;
+}
+
+inline bool isValidDate(std::string_view text)
+{
+    Date date;
+    return parseDate(text, date);
+}
+
+//        .
+// parsed[i]     0;    .
+size_t validatePhoneNumbers(const std::string_view *numbers, size_t count, uint64_t *parsed);
+
+//       .
+// valid[i] = 1    ( parsed[i] ),  0;
+//    .
+size_t validateDates(const std::string_view *dates, size_t count, Date *parsed, uint8_t *valid);
@@ -0,0 +1,99 @@
+#include "VoyageTable.h"
+
+#include <algorithm>
+
+using namespace std;
+
+uint32_t VoyageTable::find(uint32_t shipId, uint32_t date) const
+{
+    return keys.find(key(shipId, date));
+}
+
+uint32_t VoyageTable::add(uint32_t shipId, uint32_t departurePort, uint32_t destinationPort, uint32_t date)
+{
+    uint32_t voyageId = static_cast<uint32_t>(voyages.size());
+    if (!keys.insert(key(shipId, date), voyageId))
+    {
+        return keys.find(key(shipId, date));
+    }
+    voyages.emplace_back(shipId, departurePort, destinationPort, date);
+    dates.add(date, voyageId);
+
+    if (shipId >= ships.size())
+    {
+        ships.resize(shipId + 1);
+    }
+    insertByDate(ships[shipId], voyageId);
+
+    uint32_t route = static_cast<uint32_t>(routes.size());
+    if (routeKeys.insert(key(departurePort, destinationPort), route))
+    {
+        routes.emplace_back();
+    }
+    else
+    {
+        route = routeKeys.find(key(departurePort, destinationPort));
+    }
+    insertByDate(routes[route], voyageId);
+    return voyageId;
+}
+
+void VoyageTable::insertByDate(vector<uint32_t> &schedule, uint32_t voyageId)
+{
+    //      ,   -   
+    uint32_t date = voyages[voyageId].date;
+    auto position = upper_bound(schedule.begin(), schedule.end(), date, [this](uint32_t day, uint32_t other)
+                                { return day < voyages[other].date; });
+    schedule.insert(position, voyageId);
+}
+
+const vector<uint32_t> &VoyageTable::shipVoyages(uint32_t shipId) const
+{
+    static const vector<uint32_t> none;
+    return shipId < ships.size() ? ships[shipId] : none;
+}
+
+uint32_t VoyageTable::nextVoyage(uint32_t shipId, uint32_t from) const
+{
+    const vector<uint32_t> &schedule = shipVoyages(shipId);
+    auto position = lower_bound(schedule.begin(), schedule.end(), from, [this](uint32_t voyageId, uint32_t day)
+                                { return voyages[voyageId].date < day; });
+    return position == schedule.end() ? npos : *position;
+}
+
+const vector<uint32_t> &VoyageTable::routeVoyages(uint32_t departurePort, uint32_t destinationPort) const
+{
+    static const vector<uint32_t> none;
+    uint32_t route = routeKeys.find(key(departurePort, destinationPort));
+    return route == HashIndex::npos ? none : routes[route];
+}
+
+pair<const uint32_t *, const uint32_t *> VoyageTable::routeVoyagesBetween(uint32_t departurePort, uint32_t destinationPort,
+                                                                          uint32_t from, uint32_t to) const
+{
+    const vector<uint32_t> &schedule = routeVoyages(departurePort, destinationPort);
+    const uint32_t *begin = schedule.data();
+    const uint32_t *end = begin + schedule.size();
+    const uint32_t *first = lower_bound(begin, end, from, [this](uint32_t voyageId, uint32_t day)
+                                        { return voyages[voyageId].date < day; });
+    const uint32_t *last = upper_bound(first, end, to, [this](uint32_t day, uint32_t voyageId)
+                                       { return day < voyages[voyageId].date; });
+    return make_pair(first, last);
+}
+
+void VoyageTable::reserve(size_t count)
+{
+    voyages.reserve(count);
+    keys.reserve(count);
+    dates.reserve(count);
+}
+
+void VoyageTable::clear()
+{
+    voyages.clear();
+    keys.clear();
+    ships.clear();
+    routeKeys.clear();
+    routes.clear();
+    dates.clear();
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "DateIndex.h"
+#include "HashIndex.h"
+#include "Models.h"
+
+//  .    -  ,   
+//   ,      (, ).
+//     0   ;   
+//   ,    ShipInventory    .
+//        ( , 
+// )   ,   , 
+//          
+//     .
+class VoyageTable
+{
+public:
+    static const uint32_t npos = 0xFFFFFFFFu;
+
+    //       npos
+    uint32_t find(uint32_t shipId, uint32_t date) const;
+
+    //  ;        , 
+    //       
+    uint32_t add(uint32_t shipId, uint32_t departurePort, uint32_t destinationPort, uint32_t date);
+
+    const Voyage &voyage(uint32_t voyageId) const { return voyages[voyageId]; }
+
+    //      (     )
+    const std::vector<uint32_t> &shipVoyages(uint32_t shipId) const;
+
+    //        from  npos
+    uint32_t nextVoyage(uint32_t shipId, uint32_t from) const;
+
+    //      (    )
+    const std::vector<uint32_t> &routeVoyages(uint32_t departurePort, uint32_t destinationPort) const;
+
+    //       [from, to]   routeVoyages
+    std::pair<const uint32_t *, const uint32_t *> routeVoyagesBetween(uint32_t departurePort, uint32_t destinationPort,
+                                                                     uint32_t from, uint32_t to) const;
+
+    //     ( -  )
+    const DateIndex &byDate() const { return dates; }
+
+    size_t size() const { return voyages.size(); }
+    bool empty() const { return voyages.empty(); }
+
+    void reserve(size_t count);
+    void clear();
+
+private:
+    std::vector<Voyage> voyages;
+    HashIndex keys;                           // (, ) ->  
+    std::vector<std::vector<uint32_t>> ships; //      
+    HashIndex routeKeys;                      // (, ) ->   routes
+    std::vector<std::vector<uint32_t>> routes;
+    DateIndex dates;
+
+    //  0   HashIndex,      1
+    static uint64_t key(uint32_t first, uint32_t second)
+    {
+        return (static_cast<uint64_t>(first) + 1) << 32 | second;
+    }
+
+    //    ,   
+    void insertByDate(std::vector<uint32_t> &schedule, uint32_t voyageId);
+};
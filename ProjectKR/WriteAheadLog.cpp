@@ -0,0 +1,468 @@
+#include "WriteAheadLog.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "InternPool.h"
+#include "MappedFile.h"
+#include "Metrics.h"
+
+using namespace std;
+
+namespace
+{
+    const char walMagic[8] = {'K', 'R', 'W', 'A', 'L', '0', '0', '1'};
+    const size_t recordHeaderSize = 8; //     
+    const uint32_t maxRecordSize = 1 << 20;
+
+    enum class RecordType : uint8_t
+    {
+        Passenger = 1,
+        Ticket = 2
+    };
+
+    // CRC-32C ( Castagnoli)    256 
+    uint32_t crc32c(const char *data, size_t size)
+    {
+        static const array<uint32_t, 256> table = []
+        {
+            array<uint32_t, 256> result;
+            for (uint32_t i = 0; i < 256; i++)
+            {
+                uint32_t crc = i;
+                for (int bit = 0; bit < 8; bit++)
+                {
+                    crc = crc & 1 ? (crc >> 1) ^ 0x82F63B78u : crc >> 1;
+                }
+                result[i] = crc;
+            }
+            return result;
+        }();
+        uint32_t crc = 0xFFFFFFFFu;
+        for (size_t i = 0; i < size; i++)
+        {
+            crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    template <typename T>
+    void putValue(string &out, T value)
+    {
+        out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    void putString(string &out, string_view text)
+    {
+        putValue(out, static_cast<uint32_t>(text.size()));
+        out.append(text.data(), text.size());
+    }
+
+    //    ;      ok()  false
+    class RecordReader
+    {
+    public:
+        explicit RecordReader(string_view data) : data(data), valid(true) {}
+
+        template <typename T>
+        T value()
+        {
+            T result{};
+            if (data.size() < sizeof(T))
+            {
+                valid = false;
+                return result;
+            }
+            memcpy(&result, data.data(), sizeof(T));
+            data.remove_prefix(sizeof(T));
+            return result;
+        }
+
+        string_view text()
+        {
+            uint32_t length = value<uint32_t>();
+            if (!valid || data.size() < length)
+            {
+                valid = false;
+                return string_view();
+            }
+            string_view result = data.substr(0, length);
+            data.remove_prefix(length);
+            return result;
+        }
+
+        //       
+        bool ok() const { return valid && data.empty(); }
+
+    private:
+        string_view data;
+        bool valid;
+    };
+
+    bool hasMagic(const char *data, size_t size)
+    {
+        return size >= sizeof(walMagic) && memcmp(data, walMagic, sizeof(walMagic)) == 0;
+    }
+
+    //          , 
+    //   1; visit  ,    .  
+    //     (  ).
+    template <typename Visit>
+    size_t scanRecords(const char *data, size_t size, Visit visit)
+    {
+        size_t offset = sizeof(walMagic);
+        uint64_t previous = 0;
+        while (size - offset >= recordHeaderSize)
+        {
+            uint32_t length, checksum;
+            memcpy(&length, data + offset, sizeof(length));
+            memcpy(&checksum, data + offset + 4, sizeof(checksum));
+            const char *payload = data + offset + recordHeaderSize;
+            if (length > maxRecordSize || length > size - offset - recordHeaderSize || crc32c(payload, length) != checksum)
+            {
+                break;
+            }
+            RecordReader reader(string_view(payload, length));
+            uint8_t type = reader.value<uint8_t>();
+            uint64_t lsn = reader.value<uint64_t>();
+            if (lsn == 0 || (previous != 0 && lsn != previous + 1))
+            {
+                break;
+            }
+            visit(type, lsn, reader);
+            previous = lsn;
+            offset += recordHeaderSize + length;
+        }
+        return offset;
+    }
+
+    int fileDescriptor(FILE *file)
+    {
+#ifdef _WIN32
+        return _fileno(file);
+#else
+        return fileno(file);
+#endif
+    }
+
+    bool syncDescriptor(int descriptor)
+    {
+        METRIC_TIMER(Fsync);
+#ifdef _WIN32
+        return _commit(descriptor) == 0;
+#else
+        return fsync(descriptor) == 0;
+#endif
+    }
+}
+
+WriteAheadLog::WriteAheadLog(const string &filename)
+    : filename(filename), file(nullptr), appendedLsn(0), durableLsn(0), syncing(false), broken(false)
+{
+}
+
+WriteAheadLog::~WriteAheadLog()
+{
+    close();
+}
+
+bool WriteAheadLog::open()
+{
+    unique_lock<mutex> guard(lock);
+    synced.wait(guard, [this]
+                { return !syncing; });
+    return openLocked();
+}
+
+void WriteAheadLog::close()
+{
+    unique_lock<mutex> guard(lock);
+    synced.wait(guard, [this]
+                { return !syncing; });
+    closeLocked();
+}
+
+bool WriteAheadLog::openLocked()
+{
+    closeLocked();
+    size_t validEnd = 0;
+    size_t fileSize = 0;
+    uint64_t last = 0;
+    {
+        MappedFile existing;
+        if (existing.open(filename) && existing.size() > 0)
+        {
+            if (!hasMagic(existing.data(), existing.size()))
+            {
+                return false;
+            }
+            fileSize = existing.size();
+            validEnd = scanRecords(existing.data(), existing.size(), [&](uint8_t, uint64_t lsn, RecordReader &)
+                                   { last = lsn; });
+        }
+    }
+    // ,   , ,     
+    //   
+    if (fileSize > validEnd)
+    {
+        error_code error;
+        filesystem::resize_file(filename, validEnd, error);
+        if (error)
+        {
+            return false;
+        }
+    }
+
+    file = fopen(filename.c_str(), "ab");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    if (validEnd == 0 && (fwrite(walMagic, 1, sizeof(walMagic), file) != sizeof(walMagic) || fflush(file) != 0))
+    {
+        closeLocked();
+        return false;
+    }
+    //       reset
+    broken = false;
+    appendedLsn = max(appendedLsn, last);
+    durableLsn = appendedLsn;
+    return true;
+}
+
+void WriteAheadLog::closeLocked()
+{
+    if (file != nullptr)
+    {
+        fflush(file);
+        syncDescriptor(fileDescriptor(file));
+        fclose(file);
+        file = nullptr;
+        durableLsn = appendedLsn;
+    }
+}
+
+uint64_t WriteAheadLog::append(string_view record)
+{
+    return append(&record, 1);
+}
+
+uint64_t WriteAheadLog::append(const string_view *records, size_t count)
+{
+    lock_guard<mutex> guard(lock);
+    if (file == nullptr || broken || count == 0)
+    {
+        return 0;
+    }
+    //   : , ,    
+    recordBuffer.clear();
+    for (size_t i = 0; i < count; i++)
+    {
+        string_view record = records[i];
+        if (record.empty())
+        {
+            return 0;
+        }
+        size_t start = recordBuffer.size();
+        recordBuffer.append(recordHeaderSize, '\0');
+        recordBuffer += record[0];
+        putValue(recordBuffer, appendedLsn + i + 1);
+        recordBuffer.append(record.data() + 1, record.size() - 1);
+
+        uint32_t length = static_cast<uint32_t>(recordBuffer.size() - start - recordHeaderSize);
+        uint32_t checksum = crc32c(recordBuffer.data() + start + recordHeaderSize, length);
+        memcpy(&recordBuffer[start], &length, sizeof(length));
+        memcpy(&recordBuffer[start + 4], &checksum, sizeof(checksum));
+    }
+    if (fwrite(recordBuffer.data(), 1, recordBuffer.size(), file) != recordBuffer.size() || fflush(file) != 0)
+    {
+        // ϳ      :  
+        //         
+        broken = true;
+        return 0;
+    }
+    METRIC_COUNT(BytesWritten, recordBuffer.size());
+    appendedLsn += count;
+    return appendedLsn;
+}
+
+void WriteAheadLog::encodePassenger(string &out, const Passenger &passenger)
+{
+    out.clear();
+    putValue(out, static_cast<uint8_t>(RecordType::Passenger));
+    putValue(out, static_cast<int32_t>(passenger.id));
+    putString(out, passenger.name);
+    putString(out, passenger.address);
+    putString(out, passenger.phoneNumber);
+}
+
+void WriteAheadLog::encodeTicket(string &out, const Passenger &passenger, const TicketFields &ticket)
+{
+    out.clear();
+    putValue(out, static_cast<uint8_t>(RecordType::Ticket));
+    putValue(out, static_cast<int32_t>(ticket.id));
+    putValue(out, static_cast<int32_t>(passenger.id));
+    putValue(out, ticket.route.date);
+    putValue(out, static_cast<uint8_t>(ticket.cabinClass));
+    putValue(out, ticket.cabin);
+    putValue(out, ticket.price);
+    putString(out, internPool().view(ticket.route.shipId));
+    putString(out, internPool().view(ticket.route.departurePort));
+    putString(out, internPool().view(ticket.route.destinationPort));
+}
+
+bool WriteAheadLog::commit(uint64_t lsn)
+{
+    unique_lock<mutex> guard(lock);
+    lsn = min(lsn, appendedLsn);
+    while (durableLsn < lsn)
+    {
+        if (file == nullptr || broken)
+        {
+            return false;
+        }
+        if (syncing)
+        {
+            //   ;  fsync     
+            synced.wait(guard);
+            continue;
+        }
+        syncing = true;
+        uint64_t target = appendedLsn;
+        int descriptor = fileDescriptor(file);
+        guard.unlock();
+        bool ok = syncDescriptor(descriptor);
+        guard.lock();
+        syncing = false;
+        if (ok)
+        {
+            durableLsn = max(durableLsn, target);
+        }
+        synced.notify_all();
+        if (!ok)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t WriteAheadLog::lastLsn() const
+{
+    lock_guard<mutex> guard(lock);
+    return appendedLsn;
+}
+
+bool WriteAheadLog::reset()
+{
+    unique_lock<mutex> guard(lock);
+    synced.wait(guard, [this]
+                { return !syncing; });
+    bool wasOpen = file != nullptr;
+    closeLocked();
+
+    string temp = filename + ".tmp";
+    FILE *empty = fopen(temp.c_str(), "wb");
+    if (empty == nullptr)
+    {
+        return false;
+    }
+    bool ok = fwrite(walMagic, 1, sizeof(walMagic), empty) == sizeof(walMagic) && fflush(empty) == 0 &&
+              syncDescriptor(fileDescriptor(empty));
+    ok = fclose(empty) == 0 && ok;
+    if (ok)
+    {
+        error_code error;
+        filesystem::rename(temp, filename, error);
+        ok = !error;
+    }
+    return (!wasOpen || openLocked()) && ok;
+}
+
+bool replayWriteAheadLog(const string &filename, PassengerRegistry &passengers, TicketTable &tickets,
+                         IdRegistry &usedIds, IdRegistry &usedTicketIds, VoyageTable &voyages,
+                         ShipInventory &inventory, LoadStats &stats, size_t &applied)
+{
+    applied = 0;
+    MappedFile file;
+    if (!file.open(filename) || !hasMagic(file.data(), file.size()))
+    {
+        return false;
+    }
+
+    scanRecords(file.data(), file.size(), [&](uint8_t type, uint64_t, RecordReader &reader)
+                {
+                    if (type == static_cast<uint8_t>(RecordType::Passenger))
+                    {
+                        int id = reader.value<int32_t>();
+                        string_view name = reader.text();
+                        string_view address = reader.text();
+                        string_view phoneNumber = reader.text();
+                        if (!reader.ok() || id < 1)
+                        {
+                            stats.skippedRecords++;
+                        }
+                        else if (!usedIds.contains(id) &&
+                                 passengers.emplace(string(name), string(address), string(phoneNumber), id) != nullptr)
+                        {
+                            usedIds.insert(id);
+                            stats.passengers++;
+                            applied++;
+                        }
+                        return;
+                    }
+                    if (type != static_cast<uint8_t>(RecordType::Ticket))
+                    {
+                        stats.skippedRecords++;
+                        return;
+                    }
+
+                    int ticketId = reader.value<int32_t>();
+                    int passengerId = reader.value<int32_t>();
+                    uint32_t date = reader.value<uint32_t>();
+                    int cabinClass = reader.value<uint8_t>();
+                    uint32_t cabin = reader.value<uint32_t>();
+                    double price = reader.value<double>();
+                    string_view shipName = reader.text();
+                    string_view departurePort = reader.text();
+                    string_view destinationPort = reader.text();
+                    if (usedTicketIds.contains(ticketId))
+                    {
+                        return; //        
+                    }
+                    Passenger *owner = passengers.find(passengerId);
+                    if (!reader.ok() || ticketId < 1 || owner == nullptr || cabinClass < 1 || cabinClass > cabinClassCount)
+                    {
+                        stats.skippedRecords++;
+                        return;
+                    }
+
+                    //  ,    reservations.txt
+                    InternPool &pool = internPool();
+                    uint32_t ship = pool.intern(shipName);
+                    uint32_t departure = pool.intern(departurePort);
+                    uint32_t destination = pool.intern(destinationPort);
+                    Voyage route(ship, departure, destination, date);
+                    size_t knownVoyages = voyages.size();
+                    uint32_t voyageId = voyages.add(ship, departure, destination, date);
+                    if (voyages.size() != knownVoyages)
+                    {
+                        inventory.openVoyage(voyageId, ship);
+                    }
+                    uint32_t assigned = inventory.recordTicket(voyageId, cabinClass, cabin);
+                    owner->tickets.push_back(tickets.add(ticketId, voyageId, route, cabinClass, assigned, price));
+                    usedTicketIds.insert(ticketId);
+                    stats.tickets++;
+                    applied++;
+                });
+    return true;
+}
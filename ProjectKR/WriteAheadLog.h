@@ -0,0 +1,88 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "DataLoader.h"
+#include "IdRegistry.h"
+#include "Models.h"
+#include "PassengerRegistry.h"
+#include "ShipInventory.h"
+#include "TicketTable.h"
+#include "VoyageTable.h"
+
+//    (write-ahead log)     .
+//  : 8  "KRWAL001",  
+//   [  u32][CRC-32C  u32][]
+//   -  ,   (LSN,   1)    
+// ;     x86/x64.    
+//        .
+// append     ,    
+//   (kill -9); commit(lsn)     .
+// ,    commit,   fsync (
+// ):       ,    ,
+//    .   .
+class WriteAheadLog
+{
+public:
+    explicit WriteAheadLog(const std::string &filename);
+    ~WriteAheadLog();
+
+    WriteAheadLog(const WriteAheadLog &) = delete;
+    WriteAheadLog &operator=(const WriteAheadLog &) = delete;
+
+    // ³   (  ).  
+    //   ; false,   -   ProjectKR.
+    bool open();
+    void close();
+
+    //        ;
+    //   ,    
+    static void encodePassenger(std::string &out, const Passenger &passenger);
+    static void encodeTicket(std::string &out, const Passenger &passenger, const TicketFields &ticket);
+
+    //   ;  LSN   0  
+    uint64_t append(std::string_view record);
+
+    //      ;  LSN
+    //     0  
+    uint64_t append(const std::string_view *records, size_t count);
+
+    // ,     lsn    
+    bool commit(uint64_t lsn);
+
+    //     (0 -    )
+    uint64_t lastLsn() const;
+
+    //  ,           
+    // (    );    
+    bool reset();
+
+private:
+    std::string filename;
+    FILE *file;
+    mutable std::mutex lock;
+    std::condition_variable synced;
+    uint64_t appendedLsn; //    
+    uint64_t durableLsn;  //  ,   
+    bool syncing;         //     fsync
+    bool broken;          //   ;   -   open
+    std::string recordBuffer;
+
+    bool openLocked();
+    void closeLocked();
+};
+
+// ³   ,      .
+// ,      (ID    ), ,
+//         . 
+//  .  applied    ;
+// false,        ProjectKR.
+bool replayWriteAheadLog(const std::string &filename, PassengerRegistry &passengers, TicketTable &tickets,
+                         IdRegistry &usedIds, IdRegistry &usedTicketIds, VoyageTable &voyages,
+                         ShipInventory &inventory, LoadStats &stats, size_t &applied);
@@ -0,0 +1,588 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Analytics.h"
+#include "BackgroundJournal.h"
+#include "Booking.h"
+#include "DataGenerator.h"
+#include "DataLoader.h"
+#include "IdRegistry.h"
+#include "InternPool.h"
+#include "PassengerRegistry.h"
+#include "Persistence.h"
+#include "RouteSearch.h"
+#include "ShipInventory.h"
+#include "Snapshot.h"
+#include "ThreadPool.h"
+#include "TicketTable.h"
+#include "Validation.h"
+#include "VoyageTable.h"
+
+using namespace std;
+
+// ̳   ProjectKR   :
+// projectkr_bench [--passengers N] [--tickets N] [--ships N] [--ports N] [--days N]
+//                 [--seed N] [--filter TEXT] [--format json|csv] [--min-time SECONDS]
+//                 [--dir DIR] [--threads N]
+//   -   JSON ( CSV  )  
+// : ,  ,  ,     .
+//         .
+
+namespace
+{
+    struct BenchOptions
+    {
+        GeneratorOptions data;
+        string filter;           //  ,     
+        bool csv = false;
+        double minSeconds = 0.2; // ̳   
+        string directory = ".";  //    /
+    };
+
+    // ,     
+    volatile uint64_t sink;
+
+    class Reporter
+    {
+    public:
+        Reporter(const BenchOptions &options, const DataGenerator &generator)
+            : options(options), passengers(generator.passengerCount()), tickets(generator.ticketCount())
+        {
+            if (options.csv)
+            {
+                cout << "benchmark,passengers,tickets,ops,seconds,ns_per_op" << '\n';
+            }
+        }
+
+        bool selected(const string &name) const
+        {
+            return options.filter.empty() || name.find(options.filter) != string::npos;
+        }
+
+        void report(const string &name, size_t ops, double seconds)
+        {
+            double nsPerOp = ops == 0 ? 0 : seconds * 1e9 / static_cast<double>(ops);
+            if (options.csv)
+            {
+                cout << name << ',' << passengers << ',' << tickets << ',' << ops << ',' << seconds << ',' << nsPerOp << '\n';
+            }
+            else
+            {
+                cout << "{\"benchmark\":\"" << name << "\",\"passengers\":" << passengers << ",\"tickets\":" << tickets
+                     << ",\"ops\":" << ops << ",\"seconds\":" << seconds << ",\"ns_per_op\":" << nsPerOp << "}" << '\n';
+            }
+            cout.flush();
+        }
+
+        //  body (ops   ),    minSeconds
+        template <typename Body>
+        void measure(const string &name, size_t ops, Body body)
+        {
+            if (!selected(name))
+            {
+                return;
+            }
+            size_t runs = 0;
+            double seconds = 0;
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            do
+            {
+                body();
+                runs++;
+                seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            } while (seconds < options.minSeconds);
+            report(name, runs * ops, seconds);
+        }
+
+        //   ,     ( ). 
+        //  ,      .
+        template <typename Body>
+        void measureOnce(const string &name, size_t ops, Body body)
+        {
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            body();
+            if (selected(name))
+            {
+                report(name, ops, chrono::duration<double>(chrono::steady_clock::now() - start).count());
+            }
+        }
+
+    private:
+        const BenchOptions &options;
+        size_t passengers;
+        size_t tickets;
+    };
+
+    //  ,   Source.cpp,     
+    struct BenchState
+    {
+        PassengerRegistry passengers;
+        TicketTable tickets;
+        IdRegistry usedIds;
+        IdRegistry usedTicketIds;
+        VoyageTable voyages;
+        ShipInventory inventory;
+        BookingState booking{passengers, tickets, usedIds, usedTicketIds, voyages, inventory};
+    };
+
+    //     ,    "Create passenger" / "Create ticket";
+    // false,      
+    bool benchBooking(Reporter &reporter, const DataGenerator &generator, BenchState &state)
+    {
+        size_t failed = 0;
+        GeneratedPassenger passenger;
+        reporter.measureOnce("booking/createPassenger", generator.passengerCount(), [&]
+                             {
+                                 for (size_t i = 0; i < generator.passengerCount(); i++)
+                                 {
+                                     generator.passenger(i, passenger);
+                                     if (createPassenger(state.booking, passenger.name, passenger.address,
+                                                         passenger.phoneNumber, passenger.id, nullptr) != BookingStatus::Ok)
+                                     {
+                                         failed++;
+                                     }
+                                 }
+                             });
+
+        //   ,      
+        vector<TicketRequest> requests(generator.ticketCount());
+        for (size_t i = 0; i < requests.size(); i++)
+        {
+            generator.ticketRequest(i, requests[i]);
+        }
+        reporter.measureOnce("booking/issueTicket", requests.size(), [&]
+                             {
+                                 for (const TicketRequest &request : requests)
+                                 {
+                                     if (issueTicket(state.booking, request, nullptr) != BookingStatus::Ok)
+                                     {
+                                         failed++;
+                                     }
+                                 }
+                             });
+        if (failed > 0)
+        {
+            cerr << failed << " generated records were rejected by booking checks." << endl;
+        }
+        return failed == 0;
+    }
+
+    void benchAnalytics(Reporter &reporter, const DataGenerator &generator, BenchState &state)
+    {
+        const TicketTable &tickets = state.tickets;
+        uint32_t from = generator.options().firstDay;
+        uint32_t to = generator.lastDay();
+        uint32_t week = from + 6 < to ? from + 6 : to;
+
+        //    ,    
+        size_t lookups = generator.shipCount() < 1024 ? generator.shipCount() : 1024;
+        vector<string> ships(lookups);
+        for (size_t i = 0; i < lookups; i++)
+        {
+            ships[i] = DataGenerator::shipName(static_cast<uint32_t>(i));
+        }
+
+        reporter.measure("analytics/countPassengersOnShip", lookups, [&]
+                         {
+                             for (const string &ship : ships)
+                             {
+                                 sink = sink + static_cast<uint64_t>(countPassengersOnShip(state.voyages, state.inventory, ship));
+                             }
+                         });
+        reporter.measure("analytics/getUniqueShipNames", 1, [&]
+                         { sink = sink + getUniqueShipNames(tickets).size(); });
+        reporter.measure("analytics/getMostPopularCabinClasses", 1, [&]
+                         { sink = sink + getMostPopularCabinClasses(tickets).size(); });
+        reporter.measure("analytics/calculateTotalRevenue", 1, [&]
+                         { sink = sink + static_cast<uint64_t>(calculateTotalRevenue(tickets)); });
+        reporter.measure("analytics/countPassengers", 1, [&]
+                         { sink = sink + static_cast<uint64_t>(countPassengers(state.passengers)); });
+        reporter.measure("analytics/getMostPopularDestinationPorts", 1, [&]
+                         { sink = sink + getMostPopularDestinationPorts(tickets).size(); });
+        reporter.measure("analytics/getShipReport", 1, [&]
+                         { sink = sink + getShipReport(tickets).size(); });
+        reporter.measure("analytics/getVoyageReport", 1, [&]
+                         { sink = sink + getVoyageReport(tickets, state.voyages).size(); });
+        reporter.measure("analytics/getTopDestinations", 1, [&]
+                         { sink = sink + getTopDestinations(tickets, false, 10).items.size(); });
+        reporter.measure("analytics/getTopRoutes", 1, [&]
+                         { sink = sink + getTopDestinations(tickets, true, 10).items.size(); });
+        reporter.measure("analytics/getTopDestinationsWeek", 1, [&]
+                         { sink = sink + getTopDestinations(tickets, false, 10, from, week).items.size(); });
+        reporter.measure("analytics/getDeparturesBetweenWeek", 1, [&]
+                         { sink = sink + getDeparturesBetween(state.voyages, from, week).size(); });
+        reporter.measure("analytics/calculateRevenueBetweenWeek", 1, [&]
+                         { sink = sink + static_cast<uint64_t>(calculateRevenueBetween(tickets, from, week)); });
+
+        //    
+        vector<RouteQuery> queries(lookups);
+        GeneratedTicket ticket;
+        for (size_t i = 0; i < lookups; i++)
+        {
+            generator.ticket(i * generator.ticketCount() / lookups, ticket);
+            queries[i] = RouteQuery{internPool().find(DataGenerator::portName(ticket.departurePort)),
+                                    internPool().find(DataGenerator::portName(ticket.destinationPort)), ticket.date, week};
+        }
+        vector<Sailing> sailings;
+        reporter.measure("search/findSailings", lookups, [&]
+                         {
+                             for (const RouteQuery &query : queries)
+                             {
+                                 sailings.clear();
+                                 findSailings(state.voyages, state.inventory, query, sailings);
+                                 sink = sink + sailings.size();
+                             }
+                         });
+        vector<GeneratedPassenger> people(lookups);
+        for (size_t i = 0; i < lookups; i++)
+        {
+            generator.passenger(i * generator.passengerCount() / lookups, people[i]);
+        }
+        reporter.measure("search/findByPhone", lookups, [&]
+                         {
+                             for (const GeneratedPassenger &person : people)
+                             {
+                                 sink = sink + (state.passengers.findByPhone(person.phoneNumber) != nullptr);
+                             }
+                         });
+        vector<const Passenger *> found;
+        reporter.measure("search/findByNamePrefix", lookups, [&]
+                         {
+                             for (const GeneratedPassenger &person : people)
+                             {
+                                 found.clear();
+                                 sink = sink + state.passengers.findByNamePrefix(person.name.substr(0, 8), 20, found);
+                             }
+                         });
+    }
+
+    void benchValidators(Reporter &reporter, const DataGenerator &generator)
+    {
+        //    ,      
+        const size_t count = 4096;
+        vector<string> phones(count);
+        vector<string> dates(count);
+        GeneratedPassenger passenger;
+        for (size_t i = 0; i < count; i++)
+        {
+            generator.passenger(i % generator.passengerCount(), passenger);
+            phones[i] = i % 8 == 7 ? passenger.phoneNumber.substr(1) : passenger.phoneNumber;
+            formatDate(dates[i], generator.options().firstDay + static_cast<uint32_t>(i % generator.options().days));
+            if (i % 8 == 7)
+            {
+                dates[i][0] = '3';
+                dates[i][1] = '2';
+            }
+        }
+        vector<string_view> phoneViews(phones.begin(), phones.end());
+        vector<string_view> dateViews(dates.begin(), dates.end());
+        vector<uint64_t> parsedPhones(count);
+        vector<Date> parsedDates(count);
+        vector<uint8_t> validDates(count);
+
+        reporter.measure("validation/isValidPhoneNumber", count, [&]
+                         {
+                             for (string_view phone : phoneViews)
+                             {
+                                 sink = sink + isValidPhoneNumber(phone);
+                             }
+                         });
+        reporter.measure("validation/validatePhoneNumbers", count, [&]
+                         { sink = sink + validatePhoneNumbers(phoneViews.data(), count, parsedPhones.data()); });
+        reporter.measure("validation/isValidDate", count, [&]
+                         {
+                             for (string_view date : dateViews)
+                             {
+                                 sink = sink + isValidDate(date);
+                             }
+                         });
+        reporter.measure("validation/parseStoredDate", count, [&]
+                         {
+                             Date date;
+                             for (string_view text : dateViews)
+                             {
+                                 sink = sink + parseStoredDate(text, date);
+                             }
+                         });
+        reporter.measure("validation/validateDates", count, [&]
+                         { sink = sink + validateDates(dateViews.data(), count, parsedDates.data(), validDates.data()); });
+        reporter.measure("validation/isValidPrice", count, [&]
+                         {
+                             for (size_t i = 0; i < count; i++)
+                             {
+                                 sink = sink + isValidPrice(static_cast<int>(i % 3) + 1, static_cast<double>(i % 1100));
+                             }
+                         });
+    }
+
+    //   ID : IdRegistry  std::set<int>, 
+    //  ,  ID    
+    void benchIds(Reporter &reporter, const DataGenerator &generator)
+    {
+        size_t count = generator.ticketCount();
+        vector<int> ids(count);
+        GeneratedTicket ticket;
+        for (size_t i = 0; i < count; i++)
+        {
+            generator.ticket(i, ticket);
+            ids[i] = ticket.ticketId;
+        }
+        // :  ID ,  - 
+        const size_t lookups = 4096;
+        vector<int> probes(lookups);
+        for (size_t i = 0; i < lookups; i++)
+        {
+            probes[i] = static_cast<int>((i * 2654435761u) % (count * 2 + 1));
+        }
+
+        IdRegistry registry;
+        reporter.measure("ids/insert", count, [&]
+                         {
+                             registry.clear();
+                             for (int id : ids)
+                             {
+                                 sink = sink + registry.insert(id);
+                             }
+                         });
+        if (registry.empty())
+        {
+            for (int id : ids)
+            {
+                registry.insert(id);
+            }
+        }
+        reporter.measure("ids/contains", lookups, [&]
+                         {
+                             for (int id : probes)
+                             {
+                                 sink = sink + registry.contains(id);
+                             }
+                         });
+        reporter.measure("ids/nextFree", lookups, [&]
+                         {
+                             for (int id : probes)
+                             {
+                                 sink = sink + static_cast<uint64_t>(registry.nextFree(max(id, 1)));
+                             }
+                         });
+        string serialized;
+        reporter.measure("ids/serialize", count, [&]
+                         {
+                             registry.serialize(serialized);
+                             sink = sink + serialized.size();
+                         });
+        if (reporter.selected("ids/deserialize"))
+        {
+            registry.serialize(serialized);
+            IdRegistry restored;
+            reporter.measure("ids/deserialize", count, [&]
+                             { sink = sink + restored.deserialize(serialized); });
+        }
+
+        set<int> tree;
+        reporter.measure("ids/setInsert", count, [&]
+                         {
+                             tree.clear();
+                             for (int id : ids)
+                             {
+                                 sink = sink + tree.insert(id).second;
+                             }
+                         });
+        if (tree.empty())
+        {
+            tree.insert(ids.begin(), ids.end());
+        }
+        reporter.measure("ids/setContains", lookups, [&]
+                         {
+                             for (int id : probes)
+                             {
+                                 sink = sink + tree.count(id);
+                             }
+                         });
+        registry.serialize(serialized);
+        cerr << "IdRegistry: " << registry.memoryUsage() << " bytes for " << registry.size() << " IDs ("
+             << serialized.size() << " bytes serialized)." << endl;
+    }
+
+    const char *const persistenceBenchmarks[] = {"io/writePassengerFile", "io/writeReservationFile", "io/writeSnapshot",
+                                                 "io/loadPassengersFromFile", "io/loadReservationsFromFile",
+                                                 "io/restoreFromSnapshot", "io/journalAppend",
+                                                 "io/backgroundSubmit"};
+
+    //       ; false   
+    bool benchPersistence(Reporter &reporter, const BenchOptions &options, BenchState &state)
+    {
+        string prefix = options.directory + "/bench_";
+        string passengerFile = prefix + "passenger_data.txt";
+        string reservationFile = prefix + "reservations.txt";
+        string snapshotFile = prefix + "projectkr.snapshot";
+        size_t passengers = state.passengers.size();
+        size_t tickets = state.tickets.size();
+        bool ok = true;
+
+        reporter.measureOnce("io/writePassengerFile", passengers, [&]
+                             { ok = writePassengerFile(state.passengers, passengerFile) && ok; });
+        reporter.measureOnce("io/writeReservationFile", tickets, [&]
+                             { ok = writeReservationFile(state.passengers, state.tickets, reservationFile) && ok; });
+        reporter.measureOnce("io/writeSnapshot", passengers + tickets, [&]
+                             {
+                                 ok = writeSnapshot(snapshotFile, state.passengers, state.tickets, state.voyages,
+                                                    captureTextState(passengerFile, reservationFile)) && ok;
+                             });
+
+        //    ,    
+        {
+            BenchState loaded;
+            LoadStats stats;
+            reporter.measureOnce("io/loadPassengersFromFile", passengers, [&]
+                                 { ok = loadPassengersFromFile(passengerFile, loaded.passengers, loaded.usedIds, stats) && ok; });
+            reporter.measureOnce("io/loadReservationsFromFile", tickets, [&]
+                                 {
+                                     ok = loadReservationsFromFile(reservationFile, loaded.passengers, loaded.tickets,
+                                                                   loaded.usedTicketIds, loaded.voyages, loaded.inventory, stats) && ok;
+                                 });
+            if (stats.passengers != passengers || stats.tickets != tickets)
+            {
+                cerr << "Text reload restored " << stats.passengers << " passengers and " << stats.tickets << " tickets." << endl;
+                ok = false;
+            }
+        }
+        {
+            BenchState loaded;
+            LoadStats stats;
+            SnapshotView snapshot;
+            reporter.measureOnce("io/restoreFromSnapshot", passengers + tickets, [&]
+                                 {
+                                     if (snapshot.open(snapshotFile))
+                                     {
+                                         restoreFromSnapshot(snapshot, loaded.passengers, loaded.tickets, loaded.usedIds,
+                                                             loaded.usedTicketIds, loaded.voyages, loaded.inventory, stats);
+                                     }
+                                 });
+            if (loaded.passengers.size() != passengers || loaded.tickets.size() != tickets)
+            {
+                cerr << "Snapshot restored " << loaded.passengers.size() << " passengers and " << loaded.tickets.size()
+                     << " tickets." << endl;
+                ok = false;
+            }
+        }
+
+        //      (fsync 
+        //  )    ,     
+        //     ; backgroundSubmit   
+        {
+            JournalOptions journalOptions;
+            journalOptions.policy = FsyncPolicy::PerRecord;
+            journalOptions.walFilename = prefix + "projectkr.wal";
+            size_t records = min<size_t>(passengers, 20000);
+            Journal journal(passengerFile, reservationFile, journalOptions);
+            ok = journal.open() && ok;
+            reporter.measureOnce("io/journalAppend", records, [&]
+                                 {
+                                     for (size_t i = 0; i < records; i++)
+                                     {
+                                         ok = journal.appendPassenger(state.passengers[i]) &&
+                                              journal.commit(journal.lastLsn()) && ok;
+                                     }
+                                 });
+            BackgroundJournal background(journal);
+            reporter.measureOnce("io/backgroundSubmit", records, [&]
+                                 {
+                                     for (size_t i = 0; i < records; i++)
+                                     {
+                                         ok = background.submitPassenger(state.passengers[i]) != 0 && ok;
+                                     }
+                                 });
+            ok = background.stop() && ok;
+            journal.close();
+            remove(journalOptions.walFilename.c_str());
+        }
+
+        remove(passengerFile.c_str());
+        remove(reservationFile.c_str());
+        remove(snapshotFile.c_str());
+        return ok;
+    }
+
+    bool parseOptions(int argc, char *argv[], BenchOptions &options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            string arg = argv[i];
+            if (i + 1 >= argc)
+            {
+                cerr << "Missing value for option " << arg << "." << endl;
+                return false;
+            }
+            string value = argv[++i];
+            bool invalid = false;
+            if (arg == "--filter")
+            {
+                options.filter = value;
+            }
+            else if (arg == "--format")
+            {
+                invalid = value != "json" && value != "csv";
+                options.csv = value == "csv";
+            }
+            else if (arg == "--min-time")
+            {
+                options.minSeconds = atof(value.c_str());
+                invalid = options.minSeconds < 0;
+            }
+            else if (arg == "--dir")
+            {
+                options.directory = value;
+            }
+            else if (arg == "--threads")
+            {
+                setThreadPoolSize(static_cast<size_t>(max(0, atoi(value.c_str()))));
+            }
+            else if (!applyGeneratorOption(options.data, arg, value, invalid))
+            {
+                cerr << "Unknown option: " << arg << "." << endl;
+                return false;
+            }
+            if (invalid)
+            {
+                cerr << "Invalid value for " << arg << ": " << value << "." << endl;
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    BenchOptions options;
+    if (!parseOptions(argc, argv, options))
+    {
+        return 1;
+    }
+    DataGenerator generator(options.data);
+    setTicketYearWindow(generator.yearWindow());
+    cerr << "Benchmarking " << generator.passengerCount() << " passengers, " << generator.ticketCount()
+         << " tickets, " << generator.shipCount() << " ships, seed " << generator.options().seed << "." << endl;
+
+    Reporter reporter(options, generator);
+    BenchState state;
+    bool ok = benchBooking(reporter, generator, state);
+    benchAnalytics(reporter, generator, state);
+    benchValidators(reporter, generator);
+    benchIds(reporter, generator);
+    //      ,        
+    if (any_of(begin(persistenceBenchmarks), end(persistenceBenchmarks), [&](const char *name)
+               { return reporter.selected(name); }))
+    {
+        ok = benchPersistence(reporter, options, state) && ok;
+    }
+    return ok ? 0 : 1;
+}
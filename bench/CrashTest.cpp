@@ -0,0 +1,379 @@
+#include <iostream>
+
+#ifdef _WIN32
+
+//   fork  SIGKILL,    Windows
+int main()
+{
+    std::cerr << "The crash test requires POSIX fork() and kill()." << std::endl;
+    return 1;
+}
+
+#else
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Booking.h"
+#include "ConcurrentBooking.h"
+#include "DataLoader.h"
+#include "IdRegistry.h"
+#include "PassengerRegistry.h"
+#include "Persistence.h"
+#include "ShipInventory.h"
+#include "TicketTable.h"
+#include "Validation.h"
+#include "VoyageTable.h"
+#include "WriteAheadLog.h"
+
+using namespace std;
+
+//       :
+// projectkr_crash [--dir DIR] [--rounds N] [--cashiers N] [--fsync record|group] [--seed N]
+//           DIR  
+//       ConcurrentBooking.  
+//   (ConcurrentBooking  Ok)  
+//    ,       
+//  SIGKILL,      ,   
+//     .    , 
+//         
+// .  DIR   .
+
+namespace
+{
+    struct CrashOptions
+    {
+        string directory = "crash_test";
+        int rounds = 10;
+        int cashiers = 4;
+        FsyncPolicy policy = FsyncPolicy::PerRecord;
+        unsigned seed = 1;
+    };
+
+    //    ;   PIPE_BUF,   
+    //      
+    struct Acknowledgement
+    {
+        char type; // 'P' - , 'T' - 
+        int32_t id;
+    };
+
+    struct CrashState
+    {
+        PassengerRegistry passengers;
+        TicketTable tickets;
+        IdRegistry usedIds;
+        IdRegistry usedTicketIds;
+        VoyageTable voyages;
+        ShipInventory inventory;
+    };
+
+    string dataPath(const CrashOptions &options, const char *name)
+    {
+        return (filesystem::path(options.directory) / name).string();
+    }
+
+    JournalOptions journalOptions(const CrashOptions &options)
+    {
+        //  :       -   
+        JournalOptions journal;
+        journal.policy = options.policy;
+        journal.walFilename = dataPath(options, "projectkr.wal");
+        journal.compactionMinRecords = 32;
+        return journal;
+    }
+
+    // ³  ,    ;  
+    // ,     
+    size_t recover(const CrashOptions &options, CrashState &state)
+    {
+        LoadStats stats;
+        size_t recovered = 0;
+        loadPassengersFromFile(dataPath(options, "passenger_data.txt"), state.passengers, state.usedIds, stats);
+        loadReservationsFromFile(dataPath(options, "reservations.txt"), state.passengers, state.tickets, state.usedTicketIds,
+                                 state.voyages, state.inventory, stats);
+        replayWriteAheadLog(dataPath(options, "projectkr.wal"), state.passengers, state.tickets, state.usedIds,
+                            state.usedTicketIds, state.voyages, state.inventory, stats, recovered);
+        return recovered;
+    }
+
+    //  10  ID -     (6 + 2 + 2 
+    //    ),    
+    TicketRequest crashTicket(int id, const string &date)
+    {
+        static const double prices[] = {100.0, 300.0, 600.0};
+        int slot = id % 10;
+        TicketRequest request;
+        request.passengerId = id;
+        request.ticketId = id;
+        request.shipName = "Crash Ship " + to_string(id / 10);
+        request.departurePort = "Odesa";
+        request.destinationPort = "Varna";
+        request.date = date;
+        request.cabinClass = slot < 6 ? 1 : (slot < 8 ? 2 : 3);
+        request.price = prices[request.cabinClass - 1];
+        return request;
+    }
+
+    bool report(int channel, char type, int id)
+    {
+        Acknowledgement record{type, id};
+        return write(channel, &record, sizeof(record)) == static_cast<ssize_t>(sizeof(record));
+    }
+
+    //  : ,    
+    [[noreturn]] void runCashiers(const CrashOptions &options, int channel)
+    {
+        CrashState state;
+        // ³       
+        //   
+        recover(options, state);
+        Journal journal(dataPath(options, "passenger_data.txt"), dataPath(options, "reservations.txt"),
+                        journalOptions(options));
+        if (!journal.open())
+        {
+            cerr << "Error opening the data files in " << options.directory << "." << endl;
+            _exit(1);
+        }
+
+        BookingState booking{state.passengers, state.tickets, state.usedIds, state.usedTicketIds, state.voyages,
+                             state.inventory};
+        ConcurrentBooking cashiers(booking, &journal);
+        string date;
+        formatDate(date, today() + 30);
+        atomic<int> nextId(state.usedIds.maxId() + 1);
+
+        vector<thread> threads;
+        for (int cashier = 0; cashier < options.cashiers; cashier++)
+        {
+            threads.emplace_back([&]
+                                 {
+                char phoneNumber[16];
+                while (true)
+                {
+                    int id = nextId.fetch_add(1);
+                    snprintf(phoneNumber, sizeof(phoneNumber), "+380%09d", id);
+                    BookingStatus status = cashiers.createPassenger("Crash Passenger", "Crash street", phoneNumber, id);
+                    bool reported = status == BookingStatus::Ok && report(channel, 'P', id);
+                    if (reported)
+                    {
+                        status = cashiers.issueTicket(crashTicket(id, date));
+                        reported = status == BookingStatus::Ok && report(channel, 'T', id);
+                    }
+                    if (!reported)
+                    {
+                        cerr << "Cashier stopped: " << describeBookingStatus(status) << endl;
+                        _exit(1);
+                    }
+                    if (!cashiers.compactIfNeeded())
+                    {
+                        cerr << "Cashier stopped: error compacting the data files." << endl;
+                        _exit(1);
+                    }
+                } });
+        }
+        for (thread &cashier : threads)
+        {
+            cashier.join();
+        }
+        _exit(0);
+    }
+
+    //  :  , SIGKILL  delay  
+    //     
+    bool runRound(const CrashOptions &options, int round, chrono::milliseconds delay)
+    {
+        int channel[2];
+        if (pipe(channel) != 0)
+        {
+            cerr << "Error creating a pipe." << endl;
+            return false;
+        }
+        cout.flush();
+        pid_t child = fork();
+        if (child < 0)
+        {
+            cerr << "Error starting the cashier process." << endl;
+            return false;
+        }
+        if (child == 0)
+        {
+            close(channel[0]);
+            runCashiers(options, channel[1]);
+        }
+        close(channel[1]);
+
+        // ϳ,    ,   , 
+        //     SIGKILL
+        vector<Acknowledgement> acknowledged;
+        vector<char> pending;
+        auto deadline = chrono::steady_clock::time_point::max();
+        bool killed = false;
+        while (true)
+        {
+            if (!killed && chrono::steady_clock::now() >= deadline)
+            {
+                kill(child, SIGKILL);
+                killed = true;
+            }
+            int timeout = -1;
+            if (!killed && deadline != chrono::steady_clock::time_point::max())
+            {
+                auto left = chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now());
+                timeout = static_cast<int>(max<long long>(left.count(), 0));
+            }
+            pollfd descriptor{channel[0], POLLIN, 0};
+            if (poll(&descriptor, 1, timeout) == 0)
+            {
+                continue;
+            }
+            char buffer[4096];
+            ssize_t received = read(channel[0], buffer, sizeof(buffer));
+            if (received <= 0)
+            {
+                break; //  ,  
+            }
+            pending.insert(pending.end(), buffer, buffer + received);
+            size_t complete = pending.size() / sizeof(Acknowledgement);
+            for (size_t i = 0; i < complete; i++)
+            {
+                Acknowledgement record;
+                memcpy(&record, pending.data() + i * sizeof(record), sizeof(record));
+                acknowledged.push_back(record);
+            }
+            pending.erase(pending.begin(), pending.begin() + complete * sizeof(Acknowledgement));
+            if (deadline == chrono::steady_clock::time_point::max() && !acknowledged.empty())
+            {
+                deadline = chrono::steady_clock::now() + delay;
+            }
+        }
+        close(channel[0]);
+        int status = 0;
+        waitpid(child, &status, 0);
+        if (!WIFSIGNALED(status) || WTERMSIG(status) != SIGKILL)
+        {
+            cerr << "Round " << round << ": the cashier process exited before it was killed." << endl;
+            return false;
+        }
+
+        //    ,      
+        bool duringCompaction = false;
+        for (const char *name : {"passenger_data.txt.tmp", "reservations.txt.tmp", "projectkr.wal.tmp"})
+        {
+            duringCompaction = duringCompaction || filesystem::exists(dataPath(options, name));
+        }
+
+        CrashState state;
+        size_t recovered = recover(options, state);
+        size_t passengers = 0;
+        size_t tickets = 0;
+        size_t lost = 0;
+        for (const Acknowledgement &record : acknowledged)
+        {
+            const Passenger *passenger = state.passengers.find(record.id);
+            if (record.type == 'P')
+            {
+                passengers++;
+                lost += passenger == nullptr ? 1 : 0;
+            }
+            else
+            {
+                tickets++;
+                lost += passenger == nullptr || passenger->tickets.empty() || !state.usedTicketIds.contains(record.id) ? 1 : 0;
+            }
+        }
+        cout << "Round " << round << ": killed after " << delay.count() << " ms"
+             << (duringCompaction ? " during compaction" : "") << ", " << passengers
+             << " passengers and " << tickets << " tickets acknowledged, " << recovered
+             << " records replayed from the write-ahead log, " << state.passengers.size() << " passengers and "
+             << state.tickets.size() << " tickets recovered";
+        if (lost > 0)
+        {
+            cout << ", " << lost << " acknowledged records LOST." << endl;
+            return false;
+        }
+        cout << ", none lost." << endl;
+        return true;
+    }
+
+    bool parseOptions(int argc, char *argv[], CrashOptions &options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            string arg = argv[i];
+            if (i + 1 >= argc)
+            {
+                cerr << "Missing value for option " << arg << "." << endl;
+                return false;
+            }
+            string value = argv[++i];
+            if (arg == "--dir")
+            {
+                options.directory = value;
+            }
+            else if (arg == "--rounds")
+            {
+                options.rounds = max(1, atoi(value.c_str()));
+            }
+            else if (arg == "--cashiers")
+            {
+                options.cashiers = max(1, atoi(value.c_str()));
+            }
+            else if (arg == "--fsync" && (value == "record" || value == "group"))
+            {
+                options.policy = value == "record" ? FsyncPolicy::PerRecord : FsyncPolicy::GroupCommit;
+            }
+            else if (arg == "--seed")
+            {
+                options.seed = static_cast<unsigned>(strtoul(value.c_str(), nullptr, 10));
+            }
+            else
+            {
+                cerr << "Unknown option or value: " << arg << " " << value << "." << endl;
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    CrashOptions options;
+    if (!parseOptions(argc, argv, options))
+    {
+        return 1;
+    }
+    error_code error;
+    filesystem::create_directories(options.directory, error);
+    for (const char *name : {"passenger_data.txt", "reservations.txt", "projectkr.wal", "passenger_data.txt.tmp",
+                             "reservations.txt.tmp", "projectkr.wal.tmp"})
+    {
+        filesystem::remove(dataPath(options, name), error);
+    }
+
+    mt19937 random(options.seed);
+    uniform_int_distribution<int> pickDelay(5, 200);
+    bool ok = true;
+    for (int round = 1; round <= options.rounds && ok; round++)
+    {
+        ok = runRound(options, round, chrono::milliseconds(pickDelay(random)));
+    }
+    cout << (ok ? "No acknowledged booking was lost." : "Crash test FAILED.") << endl;
+    return ok ? 0 : 1;
+}
+
+#endif
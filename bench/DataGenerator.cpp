@@ -0,0 +1,284 @@
+#include "DataGenerator.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#include "CabinMap.h"
+#include "OutputBuffer.h"
+#include "Validation.h"
+
+using namespace std;
+
+namespace
+{
+    const char *const firstNames[] = {"Olena", "Andrii", "Iryna", "Taras", "Mariia", "Oleh", "Kateryna", "Dmytro",
+                                      "Sofiia", "Bohdan", "Yuliia", "Serhii", "Nataliia", "Maksym", "Oksana", "Ivan"};
+    const char *const lastNames[] = {"Kovalenko", "Shevchenko", "Bondarenko", "Tkachenko", "Kravchenko", "Melnyk",
+                                     "Boiko", "Moroz", "Lysenko", "Marchenko", "Savchenko", "Rudenko", "Petrenko",
+                                     "Klymenko", "Pavlenko", "Levchenko"};
+    const char *const cities[] = {"Kyiv", "Lviv", "Odesa", "Kharkiv", "Dnipro", "Poltava", "Chernihiv", "Uzhhorod"};
+
+    //      (seed, ) - splitmix64
+    uint64_t mix(uint64_t seed, uint64_t index)
+    {
+        uint64_t x = seed * 0x9E3779B97F4A7C15ull + index + 1;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    uint64_t gcd(uint64_t a, uint64_t b)
+    {
+        while (b != 0)
+        {
+            uint64_t r = a % b;
+            a = b;
+            b = r;
+        }
+        return a;
+    }
+
+    //      width 
+    void appendPadded(string &out, uint64_t value, size_t width)
+    {
+        char digits[24];
+        size_t length = 0;
+        do
+        {
+            digits[length++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        for (size_t i = length; i < width; i++)
+        {
+            out += '0';
+        }
+        while (length > 0)
+        {
+            out += digits[--length];
+        }
+    }
+
+    //     slot :  ,  ,  
+    int slotClass(size_t slot)
+    {
+        for (int cabinClass = 1; cabinClass <= cabinClassCount; cabinClass++)
+        {
+            if (slot < defaultCabinLayout.cabins[cabinClass - 1])
+            {
+                return cabinClass;
+            }
+            slot -= defaultCabinLayout.cabins[cabinClass - 1];
+        }
+        return cabinClassCount;
+    }
+}
+
+bool applyGeneratorOption(GeneratorOptions &options, const string &arg, const string &value, bool &invalid)
+{
+    char *end = nullptr;
+    unsigned long long number = strtoull(value.c_str(), &end, 10);
+    bool isNumber = !value.empty() && *end == '\0';
+    if (arg == "--first-date")
+    {
+        Date date;
+        invalid = !parseStoredDate(value, date);
+        if (!invalid)
+        {
+            options.firstDay = packDate(date);
+        }
+        return true;
+    }
+    size_t *count = arg == "--passengers" ? &options.passengers
+                    : arg == "--tickets"  ? &options.tickets
+                    : arg == "--ships"    ? &options.ships
+                    : arg == "--ports"    ? &options.ports
+                                          : nullptr;
+    if (count != nullptr)
+    {
+        invalid = !isNumber;
+        *count = static_cast<size_t>(number);
+        return true;
+    }
+    if (arg == "--days")
+    {
+        //   10  
+        invalid = !isNumber || number == 0 || number > 3650;
+        options.days = static_cast<uint32_t>(number);
+        return true;
+    }
+    if (arg == "--seed")
+    {
+        invalid = !isNumber;
+        options.seed = number;
+        return true;
+    }
+    return false;
+}
+
+DataGenerator::DataGenerator(const GeneratorOptions &options) : settings(options)
+{
+    settings.passengers = max<size_t>(settings.passengers, 1);
+    if (settings.tickets == 0 || settings.tickets > settings.passengers)
+    {
+        settings.tickets = settings.passengers;
+    }
+    settings.ports = max<size_t>(settings.ports, 2);
+    settings.days = max<uint32_t>(settings.days, 1);
+    if (settings.firstDay == 0)
+    {
+        settings.firstDay = today() + 1;
+    }
+    //   ,  ,      
+    size_t perVoyage = defaultCabinLayout.total();
+    size_t voyages = (settings.tickets + perVoyage - 1) / perVoyage;
+    settings.ships = max<size_t>(settings.ships, (voyages + settings.days - 1) / settings.days);
+
+    //  ,     
+    passengerStride = mix(settings.seed, 0xFFFFFFFFull) % settings.passengers;
+    while (gcd(passengerStride, settings.passengers) != 1)
+    {
+        passengerStride++;
+    }
+}
+
+void DataGenerator::passenger(size_t index, GeneratedPassenger &passenger) const
+{
+    uint64_t random = mix(settings.seed, index);
+    passenger.id = static_cast<int>(index + 1);
+    passenger.name = firstNames[random % 16];
+    passenger.name += ' ';
+    passenger.name += lastNames[(random >> 4) % 16];
+    passenger.address = cities[(random >> 8) % 8];
+    passenger.address += ", street ";
+    formatInt(passenger.address, static_cast<long long>((random >> 12) % 200 + 1));
+    //   ID      10^9:   
+    passenger.phoneNumber = "+380";
+    appendPadded(passenger.phoneNumber, (index * 387420489ull + settings.seed) % 1000000000ull, 9);
+}
+
+void DataGenerator::ticket(size_t index, GeneratedTicket &ticket) const
+{
+    size_t perVoyage = defaultCabinLayout.total();
+    size_t voyage = index / perVoyage;
+    ticket.ticketId = static_cast<int>(index + 1);
+    ticket.passengerId = static_cast<int>((index * passengerStride) % settings.passengers + 1);
+    ticket.ship = static_cast<uint32_t>(voyage % settings.ships);
+    ticket.date = settings.firstDay + static_cast<uint32_t>(voyage / settings.ships);
+
+    //     ,       
+    uint64_t route = mix(settings.seed ^ 0x5EA5, voyage);
+    ticket.departurePort = static_cast<uint32_t>(route % settings.ports);
+    ticket.destinationPort = static_cast<uint32_t>((ticket.departurePort + 1 + (route >> 32) % (settings.ports - 1)) % settings.ports);
+
+    ticket.cabinClass = slotClass(index % perVoyage);
+    uint64_t random = mix(settings.seed ^ 0x71C7, index);
+    static const double lowest[] = {51, 251, 501};
+    static const double spread[] = {198, 248, 498};
+    ticket.price = lowest[ticket.cabinClass - 1] + static_cast<double>(random % 1000) / 1000 * spread[ticket.cabinClass - 1];
+    //    ,   ,  
+    ticket.price = static_cast<double>(static_cast<long long>(ticket.price * 100)) / 100;
+}
+
+string DataGenerator::shipName(uint32_t ship)
+{
+    return "Ship" + to_string(ship);
+}
+
+string DataGenerator::portName(uint32_t port)
+{
+    return "Port" + to_string(port);
+}
+
+void DataGenerator::ticketRequest(size_t index, TicketRequest &request) const
+{
+    GeneratedTicket generated;
+    ticket(index, generated);
+    request.passengerId = generated.passengerId;
+    request.ticketId = generated.ticketId;
+    request.shipName = shipName(generated.ship);
+    request.departurePort = portName(generated.departurePort);
+    request.destinationPort = portName(generated.destinationPort);
+    request.date.clear();
+    formatDate(request.date, generated.date);
+    request.cabinClass = generated.cabinClass;
+    request.cabin = 0;
+    request.price = generated.price;
+}
+
+bool DataGenerator::writeFiles(const string &directory) const
+{
+    string prefix = directory.empty() ? "" : directory + "/";
+    FILE *passengerFile = fopen((prefix + "passenger_data.txt").c_str(), "wb");
+    FILE *reservationFile = fopen((prefix + "reservations.txt").c_str(), "wb");
+    bool ok = passengerFile != nullptr && reservationFile != nullptr;
+    if (ok)
+    {
+        OutputBuffer out(passengerFile);
+        GeneratedPassenger generated;
+        for (size_t i = 0; i < settings.passengers; i++)
+        {
+            passenger(i, generated);
+            string &text = out.text();
+            text += "Passenger\nName: ";
+            text += generated.name;
+            text += "\nAddress: ";
+            text += generated.address;
+            text += "\nPhone number: ";
+            text += generated.phoneNumber;
+            text += "\nID: ";
+            formatInt(text, generated.id);
+            text += "\n\n";
+            out.commit();
+        }
+        ok = out.flush();
+    }
+    if (ok)
+    {
+        //  reservations.txt:      
+        OutputBuffer out(reservationFile);
+        GeneratedPassenger owner;
+        GeneratedTicket generated;
+        for (size_t i = 0; i < settings.tickets; i++)
+        {
+            ticket(i, generated);
+            passenger(static_cast<size_t>(generated.passengerId - 1), owner);
+            string &text = out.text();
+            text += "Reservations for Passenger: ";
+            text += owner.name;
+            text += " (ID: ";
+            formatInt(text, owner.id);
+            text += ")\nTicket ID: ";
+            formatInt(text, generated.ticketId);
+            text += "\nShip Name: ";
+            text += shipName(generated.ship);
+            text += "\nDeparture Port: ";
+            text += portName(generated.departurePort);
+            text += "\nDestination Port: ";
+            text += portName(generated.destinationPort);
+            text += "\nDate: ";
+            formatDate(text, generated.date);
+            text += "\nCabin Class: ";
+            formatInt(text, generated.cabinClass);
+            text += "\nPrice: $";
+            formatPrice(text, generated.price);
+            text += "\n\n";
+            out.commit();
+        }
+        ok = out.flush();
+    }
+    if (passengerFile != nullptr)
+    {
+        ok = fclose(passengerFile) == 0 && ok;
+    }
+    if (reservationFile != nullptr)
+    {
+        ok = fclose(reservationFile) == 0 && ok;
+    }
+    return ok;
+}
+
+YearWindow DataGenerator::yearWindow() const
+{
+    return YearWindow{unpackDate(settings.firstDay).year, unpackDate(lastDay()).year};
+}
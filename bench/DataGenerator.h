@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Booking.h"
+#include "Validation.h"
+
+//    : , ,   .
+//     seed      , 
+// -    ,    50M  
+//      '.  seed   .
+//    (, )     
+//  ,         
+//   ;      , 
+//   .
+struct GeneratorOptions
+{
+    size_t passengers = 1000;
+    size_t tickets = 0;    //   passengers; 0 -    
+    size_t ships = 0;      // 0 - ,       days 
+    size_t ports = 20;
+    uint32_t days = 60;    //  ,   firstDay
+    uint32_t firstDay = 0; //   (packDate); 0 - 
+    uint64_t seed = 1;
+};
+
+struct GeneratedPassenger
+{
+    int id;
+    std::string name;
+    std::string address;
+    std::string phoneNumber;
+};
+
+struct GeneratedTicket
+{
+    int ticketId;
+    int passengerId;
+    uint32_t ship; //    :  "Ship<n>", "Port<n>"
+    uint32_t departurePort;
+    uint32_t destinationPort;
+    uint32_t date;
+    int cabinClass;
+    double price;
+};
+
+//       (--passengers, --tickets,
+// --ships, --ports, --days, --first-date dd/mm/yy, --seed).  false,
+//  arg    ; invalid = true,   .
+bool applyGeneratorOption(GeneratorOptions &options, const std::string &arg, const std::string &value, bool &invalid);
+
+class DataGenerator
+{
+public:
+    //       
+    explicit DataGenerator(const GeneratorOptions &options);
+
+    const GeneratorOptions &options() const { return settings; }
+    size_t passengerCount() const { return settings.passengers; }
+    size_t ticketCount() const { return settings.tickets; }
+    size_t shipCount() const { return settings.ships; }
+    uint32_t lastDay() const { return settings.firstDay + settings.days - 1; }
+
+    void passenger(size_t index, GeneratedPassenger &passenger) const;
+    void ticket(size_t index, GeneratedTicket &ticket) const;
+
+    static std::string shipName(uint32_t ship);
+    static std::string portName(uint32_t port);
+
+    //      Booking (,  dd/mm/yy)
+    void ticketRequest(size_t index, TicketRequest &request) const;
+
+    //   passenger_data.txt  reservations.txt   directory
+    bool writeFiles(const std::string &directory) const;
+
+    // ³ ,      ( setTicketYearWindow)
+    YearWindow yearWindow() const;
+
+private:
+    GeneratorOptions settings;
+    uint64_t passengerStride; //    : i * stride mod n
+};
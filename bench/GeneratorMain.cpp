@@ -0,0 +1,57 @@
+#include <iostream>
+#include <string>
+
+#include "DataGenerator.h"
+#include "Validation.h"
+
+using namespace std;
+
+//     ProjectKR:
+// projectkr_gen [--out DIR] [--passengers N] [--tickets N] [--ships N] [--ports N]
+//               [--days N] [--first-date dd/mm/yy] [--seed N]
+//  passenger_data.txt  reservations.txt  DIR (  -  ).
+int main(int argc, char *argv[])
+{
+    GeneratorOptions options;
+    string directory;
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            cerr << "Missing value for option " << arg << "." << endl;
+            return 1;
+        }
+        string value = argv[++i];
+        bool invalid = false;
+        if (arg == "--out")
+        {
+            directory = value;
+        }
+        else if (!applyGeneratorOption(options, arg, value, invalid))
+        {
+            cerr << "Unknown option: " << arg << "." << endl;
+            return 1;
+        }
+        if (invalid)
+        {
+            cerr << "Invalid value for " << arg << ": " << value << "." << endl;
+            return 1;
+        }
+    }
+
+    DataGenerator generator(options);
+    if (!generator.writeFiles(directory))
+    {
+        cerr << "Error writing data files." << endl;
+        return 1;
+    }
+    string first, last;
+    formatDate(first, generator.options().firstDay);
+    formatDate(last, generator.lastDay());
+    YearWindow years = generator.yearWindow();
+    cout << "Generated " << generator.passengerCount() << " passengers and " << generator.ticketCount()
+         << " tickets on " << generator.shipCount() << " ships, departures " << first << " - " << last
+         << " (run ProjectKR with --years " << years.first << '-' << years.last << ")." << endl;
+    return 0;
+}
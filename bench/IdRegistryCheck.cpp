@@ -0,0 +1,149 @@
+#include <climits>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+
+#include "IdRegistry.h"
+
+using namespace std;
+
+//    IdRegistry (   ID):
+// projectkr_idcheck
+//   -      
+// serialize  ,    (,   , 
+//   ,    ) - 
+//      .   ctest.
+
+namespace
+{
+    int failures = 0;
+
+    void check(bool condition, const char *what)
+    {
+        if (!condition)
+        {
+            cerr << "FAILED: " << what << endl;
+            failures++;
+        }
+    }
+
+    //    ID,   ( )  ID  INT_MAX
+    void fill(IdRegistry &registry, set<int> &expected)
+    {
+        mt19937 random(7);
+        for (int i = 0; i < 20000; i++)
+        {
+            int id = static_cast<int>(random() % 5000000) + 1;
+            registry.insert(id);
+            expected.insert(id);
+        }
+        for (int id = 1 << 20; id < (1 << 20) + 30000; id++)
+        {
+            registry.insert(id);
+            expected.insert(id);
+        }
+        for (int id : {INT_MAX - 2, INT_MAX})
+        {
+            registry.insert(id);
+            expected.insert(id);
+        }
+    }
+
+    void checkRoundTrip(const IdRegistry &registry, const set<int> &expected, const string &data)
+    {
+        IdRegistry restored;
+        check(restored.deserialize(data), "round trip is accepted");
+        check(restored.size() == expected.size() && restored.maxId() == *expected.rbegin(),
+              "round trip keeps the size and the largest ID");
+        bool same = true;
+        for (int id : expected)
+        {
+            same = same && restored.contains(id);
+        }
+        check(same, "round trip keeps every ID");
+        string again;
+        restored.serialize(again);
+        check(again == data, "round trip gives the same bytes");
+        check(registry.nextFree(1 << 20) == restored.nextFree(1 << 20), "round trip keeps free IDs");
+    }
+
+    void checkRejected(const string &data, const char *what)
+    {
+        IdRegistry restored;
+        restored.insert(1);
+        check(!restored.deserialize(data) && restored.empty(), what);
+    }
+
+    void checkCorruption(const string &data)
+    {
+        checkRejected(string(), "empty data is rejected");
+        checkRejected(data.substr(0, data.size() - 1), "truncated data is rejected");
+        checkRejected(data + '\0', "trailing bytes are rejected");
+
+        string header = data;
+        header[0] ^= 0x20;
+        checkRejected(header, "a wrong magic number is rejected");
+
+        //   -     ;   
+        //    ID 
+        size_t bitmapBytes = 1024 * sizeof(uint64_t);
+        IdRegistry single;
+        for (int id = 1; id <= 5000; id++)
+        {
+            single.insert(id);
+        }
+        string dense;
+        single.serialize(dense);
+        dense.replace(dense.size() - bitmapBytes, bitmapBytes, bitmapBytes, '\0');
+        checkRejected(dense, "an empty bitmap container is rejected");
+
+        //  :   ,   , 
+        //      
+        mt19937 random(11);
+        bool consistent = true;
+        for (int round = 0; round < 2000; round++)
+        {
+            string damaged = data;
+            for (int flips = 1 + static_cast<int>(random() % 4); flips > 0; flips--)
+            {
+                damaged[random() % damaged.size()] ^= static_cast<char>(1 + random() % 255);
+            }
+            IdRegistry restored;
+            if (restored.deserialize(damaged))
+            {
+                //    ( 12-15)  
+                damaged.replace(12, 4, 4, '\0');
+                string again;
+                restored.serialize(again);
+                consistent = consistent && again == damaged;
+            }
+            else
+            {
+                consistent = consistent && restored.empty();
+            }
+        }
+        check(consistent, "damaged data is rejected or restored consistently");
+    }
+}
+
+int main()
+{
+    IdRegistry registry;
+    set<int> expected;
+    fill(registry, expected);
+    string data;
+    registry.serialize(data);
+
+    checkRoundTrip(registry, expected, data);
+    checkCorruption(data);
+
+    if (failures > 0)
+    {
+        cout << failures << " ID registry checks FAILED." << endl;
+        return 1;
+    }
+    cout << "ID registry serialization checks passed." << endl;
+    return 0;
+}